@@ -0,0 +1,229 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "external_lcp_builder.h"
+#include "external_memory.h"
+#include "mapped_file.h"
+
+#include <tuple>
+
+using namespace randomness::algorithm;
+
+struct PairRecord {
+    uint64_t first;
+    uint64_t second;
+    uint64_t position;
+
+    bool operator<(const PairRecord& other) const
+    {
+        return std::tie(first, second, position) < std::tie(other.first, other.second, other.position);
+    }
+};
+
+struct RankRecord {
+    uint64_t position;
+    uint64_t rank;
+
+    bool operator<(const RankRecord& other) const
+    {
+        return position < other.position;
+    }
+};
+
+struct PhiRecord {
+    uint64_t position;
+    uint64_t previous;
+    uint64_t rank;
+
+    bool operator<(const PhiRecord& other) const
+    {
+        return position < other.position;
+    }
+};
+
+struct LcpRecord {
+    uint64_t rank;
+    uint64_t lcp;
+
+    bool operator<(const LcpRecord& other) const
+    {
+        return rank < other.rank;
+    }
+};
+
+static size_t BitLength(uint64_t value)
+{
+    size_t bits = 0;
+    while ((bits < 64) && (value >> bits) > 0) {
+        bits += 1;
+    }
+    return bits;
+}
+
+/**
+ * External prefix doubling. Each round sorts (rank[i], rank[i + h], i) on disk, and the dense
+ * renaming is sorted back into text order so that rank[i] and rank[i + h] can be read by two
+ * sequential readers of the same file. The first round ranks by as many symbols as fit in 64 bits.
+ * The positions of the last round, in sorted order, are the suffix array.
+ */
+static std::unique_ptr<RecordFile<uint64_t>> SortSuffixes(const uint8_t* data, size_t length, size_t memoryBudget, const std::string& directory)
+{
+    auto symbolBits = BitLength(*std::max_element(data, data + length) + 1);
+    auto h = 64 / symbolBits;
+
+    auto pairs = std::unique_ptr<ExternalSorter<PairRecord>>(new ExternalSorter<PairRecord>(memoryBudget / 2, directory));
+    for (size_t i = 0; i < length; ++i) {
+        uint64_t key = 0;
+        for (size_t j = 0; j < h; ++j) {
+            // symbols are shifted by one so that 0 pads the suffixes shorter than h
+            key = (key << symbolBits) | ((i + j < length) ? data[i + j] + 1 : 0);
+        }
+        pairs->Push({ key, 0, i });
+    }
+
+    for (;; h <<= 1) {
+        auto sa = std::unique_ptr<RecordFile<uint64_t>>(new RecordFile<uint64_t>(directory));
+        ExternalSorter<RankRecord> ranks(memoryBudget / 2, directory);
+
+        pairs->Sort();
+
+        PairRecord pair, last;
+        uint64_t rank = 0;
+        for (size_t i = 0; pairs->Next(pair); ++i) {
+            if ((i > 0) && ((pair.first != last.first) || (pair.second != last.second))) {
+                rank += 1;
+            }
+            ranks.Push({ pair.position, rank });
+            sa->Append(pair.position);
+            last = pair;
+        }
+        pairs.reset();
+
+        if (rank == length - 1) {
+            sa->Flush();
+            return sa;
+        }
+
+        RecordFile<uint64_t> rank_file(directory);
+        RankRecord record;
+
+        ranks.Sort();
+        while (ranks.Next(record)) {
+            rank_file.Append(record.rank);
+        }
+        rank_file.Flush();
+
+        auto bufferRecords = memoryBudget / 8 / sizeof(uint64_t);
+        RecordReader<uint64_t> heads(rank_file, 0, bufferRecords);
+        RecordReader<uint64_t> tails(rank_file, h, bufferRecords);
+
+        pairs.reset(new ExternalSorter<PairRecord>(memoryBudget / 2, directory));
+        for (size_t i = 0; i < length; ++i) {
+            uint64_t first = 0, second = 0;
+            heads.Next(first);
+
+            // rank 0 of the second half is reserved for suffixes shorter than h
+            if ((i + h < length) && tails.Next(second)) {
+                second += 1;
+            }
+            pairs->Push({ first, second, i });
+        }
+    }
+}
+
+ExternalLcpBuilder::ExternalLcpBuilder(size_t memoryBudget, const std::string& temporaryDirectory) : memoryBudget(memoryBudget), temporaryDirectory(temporaryDirectory)
+{
+}
+
+LcpArray ExternalLcpBuilder::Build(const uint8_t* data, size_t length) const
+{
+    if (SuffixArray::IsNarrow(length)) {
+        return Build<uint32_t>(data, length);
+    }
+    else {
+        return Build<uint64_t>(data, length);
+    }
+}
+
+/**
+ * Phi algorithm on disk: (sa[r], sa[r - 1], r) is sorted into text order, where the permuted lcp
+ * is computed by one scan over the sample, and the results are sorted back into suffix array order.
+ */
+template <typename Index>
+LcpArray ExternalLcpBuilder::Build(const uint8_t* data, size_t length) const
+{
+    RecordFile<Index> lcp_file(temporaryDirectory);
+    size_t max_lcp = 0;
+
+    if (length > 0) {
+        ExternalSorter<PhiRecord> phi(memoryBudget / 2, temporaryDirectory);
+        {
+            auto sa = SortSuffixes(data, length, memoryBudget, temporaryDirectory);
+            RecordReader<uint64_t> reader(*sa, 0, memoryBudget / 8 / sizeof(uint64_t));
+
+            // length marks the smallest suffix, which has no predecessor
+            uint64_t position = 0, previous = length;
+            for (size_t r = 0; reader.Next(position); ++r) {
+                phi.Push({ position, previous, r });
+                previous = position;
+            }
+        }
+
+        ExternalSorter<LcpRecord> lcps(memoryBudget / 2, temporaryDirectory);
+        PhiRecord record;
+        size_t lcp = 0;
+
+        phi.Sort();
+        while (phi.Next(record)) {
+            if (record.previous == length) {
+                lcp = 0;
+            }
+            else {
+                lcp = LcpArray::ExtendMatch(data, length, record.position, record.previous, lcp);
+            }
+
+            lcps.Push({ record.rank, lcp });
+            max_lcp = std::max(max_lcp, lcp);
+            lcp -= (lcp > 0);
+        }
+
+        LcpRecord value;
+
+        lcps.Sort();
+        while (lcps.Next(value)) {
+            lcp_file.Append(static_cast<Index>(value.lcp));
+        }
+    }
+
+    lcp_file.Append(Index(0));
+    lcp_file.Flush();
+
+    auto mapped = MappedFile::Map(lcp_file.Descriptor(), lcp_file.Count() * sizeof(Index));
+
+    LcpArray lcp_array;
+    lcp_array.length = length;
+    lcp_array.max_lcp = max_lcp;
+    lcp_array.Attach(mapped, static_cast<const Index*>(mapped->Data()));
+    return lcp_array;
+}
\ No newline at end of file
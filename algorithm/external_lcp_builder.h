@@ -0,0 +1,56 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_ALGORITHM_EXTERNAL_LCP_BUILDER_H__
+#define __RANDOMNESS_ALGORITHM_EXTERNAL_LCP_BUILDER_H__
+
+#include "lcp_array.h"
+
+#include <string>
+
+namespace randomness { namespace algorithm {
+
+    /**
+     * Builds the LCP array of a sample whose suffix and LCP arrays do not fit in memory.
+     * Only the sample itself has to stay in memory; everything else is sorted in blocks on
+     * temporary files within memoryBudget bytes. The result is mapped from disk. The temporary 
+     * files go to temporaryDirectory, or where tmpfile() puts them when it is empty.
+     */
+    class ExternalLcpBuilder {
+    private:
+        size_t memoryBudget;
+        std::string temporaryDirectory;
+
+    public:
+        explicit ExternalLcpBuilder(size_t memoryBudget, const std::string& temporaryDirectory = std::string());
+
+        LcpArray Build(const uint8_t* data, size_t length) const;
+
+    private:
+        template <typename Index>
+        LcpArray Build(const uint8_t* data, size_t length) const;
+    };
+}}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_ALGORITHM_EXTERNAL_MEMORY_H__
+#define __RANDOMNESS_ALGORITHM_EXTERNAL_MEMORY_H__
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace randomness { namespace algorithm {
+
+    /**
+     * Temporary file of fixed-size records, appended sequentially and removed when closed. It is 
+     * created in directory, or where tmpfile() puts it when directory is empty.
+     */
+    template <typename Record>
+    class RecordFile {
+    private:
+        FILE* file;
+        size_t count = 0;
+
+    public:
+        explicit RecordFile(const std::string& directory = std::string()) : file(Open(directory))
+        {
+            if (file == nullptr) {
+                throw std::runtime_error("temporary file creation failed");
+            }
+        }
+
+        RecordFile(const RecordFile&) = delete;
+        RecordFile& operator=(const RecordFile&) = delete;
+
+        ~RecordFile()
+        {
+            std::fclose(file);
+        }
+
+        void Append(const Record* records, size_t countRecords)
+        {
+            if (std::fwrite(records, sizeof(Record), countRecords, file) != countRecords) {
+                throw std::runtime_error("temporary file write failed");
+            }
+            count += countRecords;
+        }
+
+        void Append(const Record& record)
+        {
+            Append(&record, 1);
+        }
+
+        // must be called before the records are read back
+        void Flush()
+        {
+            if (std::fflush(file) != 0) {
+                throw std::runtime_error("temporary file write failed");
+            }
+        }
+
+        size_t Count() const
+        {
+            return count;
+        }
+
+        int Descriptor() const
+        {
+            return fileno(file);
+        }
+
+    private:
+        // the name is removed at once, so that the file goes away with its descriptor
+        static FILE* Open(const std::string& directory)
+        {
+            if (directory.empty()) {
+                return std::tmpfile();
+            }
+
+            auto name = directory + "/records-XXXXXX";
+            auto descriptor = mkstemp(&name[0]);
+            if (descriptor < 0) {
+                return nullptr;
+            }
+            unlink(name.c_str());
+
+            auto file = fdopen(descriptor, "w+b");
+            if (file == nullptr) {
+                close(descriptor);
+            }
+            return file;
+        }
+    };
+
+    /**
+     * Sequential reader of a RecordFile from a given record on. Several readers can share a file.
+     */
+    template <typename Record>
+    class RecordReader {
+    private:
+        int descriptor;
+        size_t next;
+        size_t end;
+        std::vector<Record> buffer;
+        size_t cursor = 0;
+        size_t filled = 0;
+
+    public:
+        RecordReader(const RecordFile<Record>& file, size_t first, size_t bufferRecords)
+            : descriptor(file.Descriptor()), next(first), end(file.Count()), buffer(std::max<size_t>(bufferRecords, 1))
+        {
+        }
+
+        bool Next(Record& record)
+        {
+            if ((cursor == filled) && (Fill() == false)) {
+                return false;
+            }
+
+            record = buffer[cursor++];
+            return true;
+        }
+
+    private:
+        bool Fill()
+        {
+            if (next >= end) {
+                return false;
+            }
+
+            auto countRecords = std::min(buffer.size(), end - next);
+            auto bytes = reinterpret_cast<char*>(buffer.data());
+            size_t done = 0;
+
+            while (done < countRecords * sizeof(Record)) {
+                auto read = pread(descriptor, bytes + done, countRecords * sizeof(Record) - done, next * sizeof(Record) + done);
+                if (read <= 0) {
+                    throw std::runtime_error("temporary file read failed");
+                }
+                done += read;
+            }
+
+            next += countRecords;
+            cursor = 0;
+            filled = countRecords;
+            return true;
+        }
+    };
+
+    /**
+     * Sorts more records than fit in memory: runs of at most memoryBudget bytes are sorted and
+     * written to temporary files in directory, then merged in a single pass. Nothing is written 
+     * to disk when all records fit in one run. The run buffer, and later the merge buffers with 
+     * their heap, stay within memoryBudget bytes.
+     */
+    template <typename Record, typename Less = std::less<Record>>
+    class ExternalSorter {
+    private:
+        struct Head {
+            Record record;
+            size_t run;
+        };
+
+        struct HeadGreater {
+            bool operator()(const Head& x, const Head& y) const
+            {
+                return Less()(y.record, x.record);
+            }
+        };
+
+        size_t capacity;
+        std::string directory;
+        std::vector<Record> buffer;
+        size_t cursor = 0;
+
+        std::vector<std::unique_ptr<RecordFile<Record>>> runs;
+        std::vector<std::unique_ptr<RecordReader<Record>>> readers;
+        std::priority_queue<Head, std::vector<Head>, HeadGreater> heads;
+
+    public:
+        explicit ExternalSorter(size_t memoryBudget, const std::string& directory = std::string()) 
+            : capacity(std::max<size_t>(memoryBudget / sizeof(Record), 1)), directory(directory)
+        {
+        }
+
+        void Push(const Record& record)
+        {
+            // grown by hand, only as far as the old and the new buffer fit the budget together
+            if (buffer.size() == buffer.capacity()) {
+                auto grown = std::min(std::max<size_t>(buffer.size() * 2, 1), capacity - buffer.size());
+                if (grown > buffer.size()) {
+                    buffer.reserve(grown);
+                }
+                else {
+                    Spill();
+                }
+            }
+
+            buffer.push_back(record);
+        }
+
+        // ends the input; the records are then taken out in order with Next
+        void Sort()
+        {
+            if (runs.empty()) {
+                std::sort(buffer.begin(), buffer.end(), Less());
+                return;
+            }
+
+            if (buffer.empty() == false) {
+                Spill();
+            }
+            std::vector<Record>().swap(buffer);
+
+            // the heap takes its share of the budget first
+            auto heapRecords = (runs.size() * sizeof(Head) + sizeof(Record) - 1) / sizeof(Record);
+            auto bufferRecords = (capacity > heapRecords) ? (capacity - heapRecords) / runs.size() : 1;
+
+            auto storage = std::vector<Head>();
+            storage.reserve(runs.size());
+            heads = decltype(heads)(HeadGreater(), std::move(storage));
+
+            for (size_t run = 0; run < runs.size(); ++run) {
+                readers.emplace_back(new RecordReader<Record>(*runs[run], 0, bufferRecords));
+
+                Head head = { Record(), run };
+                if (readers[run]->Next(head.record)) {
+                    heads.push(head);
+                }
+            }
+        }
+
+        bool Next(Record& record)
+        {
+            if (runs.empty()) {
+                if (cursor == buffer.size()) {
+                    return false;
+                }
+                record = buffer[cursor++];
+                return true;
+            }
+
+            if (heads.empty()) {
+                return false;
+            }
+
+            auto head = heads.top();
+            heads.pop();
+            record = head.record;
+
+            if (readers[head.run]->Next(head.record)) {
+                heads.push(head);
+            }
+            return true;
+        }
+
+    private:
+        void Spill()
+        {
+            std::sort(buffer.begin(), buffer.end(), Less());
+
+            runs.emplace_back(new RecordFile<Record>(directory));
+            runs.back()->Append(buffer.data(), buffer.size());
+            runs.back()->Flush();
+
+            buffer.clear();
+        }
+    };
+}}
+
+#endif
\ No newline at end of file
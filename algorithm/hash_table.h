@@ -0,0 +1,140 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_ALGORITHM_HASH_TABLE_H__
+#define __RANDOMNESS_ALGORITHM_HASH_TABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace randomness { namespace algorithm {
+
+    // spreads the bits of a key over the whole word, as the finalizer of SplitMix64 does
+    inline uint64_t MixBits(uint64_t key)
+    {
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111eb;
+        return key ^ (key >> 31);
+    }
+
+    struct IntegerHash {
+        uint64_t operator()(uint64_t key) const
+        {
+            return MixBits(key);
+        }
+    };
+
+    /**
+     * Open-addressing hash table with linear probing, for keys that are never removed. 
+     * The capacity is a power of two, doubled whenever the table gets half full.
+     */
+    template <typename Key, typename Value, typename Hash = IntegerHash>
+    class HashTable 
+    {
+    private:
+        static constexpr size_t InitialCapacity = 64;
+
+        struct slot_t {
+            Key key;
+            Value value;
+            bool used = false;
+        };
+
+        std::vector<slot_t> slots;
+        size_t mask;
+        size_t count;
+
+    public:
+        HashTable()
+        {
+            Clear();
+        }
+
+        void Clear()
+        {
+            slots = std::vector<slot_t>(InitialCapacity);
+            mask = InitialCapacity - 1;
+            count = 0;
+        }
+
+        size_t Size() const
+        {
+            return count;
+        }
+
+        Value* Find(const Key& key)
+        {
+            auto& slot = SlotOf(key);
+            return slot.used ? &slot.value : nullptr;
+        }
+
+        // inserts a value-initialized entry for a missing key
+        Value& operator[](const Key& key)
+        {
+            auto* slot = &SlotOf(key);
+            if (slot->used) {
+                return slot->value;
+            }
+
+            if (2 * (count + 1) > slots.size()) {
+                Grow();
+                slot = &SlotOf(key);
+            }
+
+            slot->key = key;
+            slot->value = Value();
+            slot->used = true;
+            count += 1;
+
+            return slot->value;
+        }
+
+    private:
+        slot_t& SlotOf(const Key& key)
+        {
+            auto pos = Hash()(key) & mask;
+            while (slots[pos].used && (slots[pos].key == key) == false) {
+                pos = (pos + 1) & mask;
+            }
+            return slots[pos];
+        }
+
+        void Grow()
+        {
+            auto old = std::vector<slot_t>(2 * slots.size());
+            old.swap(slots);
+            mask = slots.size() - 1;
+
+            for (auto& slot : old) {
+                if (slot.used) {
+                    SlotOf(slot.key) = std::move(slot);
+                }
+            }
+        }
+    };
+}}
+
+#endif
\ No newline at end of file
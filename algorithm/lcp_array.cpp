@@ -25,63 +25,150 @@
 #include "lcp_array.h"
 
 #include <algorithm>
+#include <cstring>
+
+#include <omp.h>
 
 using namespace randomness::algorithm;
+using namespace randomness::common;
 
-LcpArray LcpArray::Create(const SuffixArray& sa)
+LcpArray LcpArray::Create(const SuffixArray& sa, size_t countThreads)
 {
     LcpArray lcp;
-    lcp.Build(sa);
+    lcp.Build(sa, countThreads);
     return lcp;
 }
 
-LcpArray LcpArray::Create(const uint8_t* data, size_t length)
+LcpArray LcpArray::Create(const uint8_t* data, size_t length, size_t countThreads)
 {
-    auto sa = SuffixArray::Create(data, length);
-    return Create(sa);
+    auto sa = SuffixArray::Create(data, length, countThreads);
+    return Create(sa, countThreads);
 }
 
-void LcpArray::Build(const SuffixArray& sa)
+void LcpArray::Build(const SuffixArray& sa, size_t countThreads)
 {
-    auto length = sa.Length();
-
-    lcp_array.clear();
-    lcp_array.assign(length, 0);
+    length = sa.Length();
 
-    auto rank = std::vector<size_t>(length, 0);
-    for (size_t i = 0; i < length; ++i) {
-        rank[sa[i]] = i;
+    if (SuffixArray::IsNarrow(length)) {
+        Build<uint32_t>(sa, countThreads);
     }
+    else {
+        Build<uint64_t>(sa, countThreads);
+    }
+}
 
-    size_t lcp = 0;
-    for (size_t i = 0; i < length; ++i) {
-        if (lcp > 0) {
-            lcp -= 1;
-        }
+void LcpArray::Attach(std::shared_ptr<const void> storage, const uint32_t* values)
+{
+    this->storage = storage;
+    narrow_array = values;
+    wide_array = nullptr;
+}
 
-        if (rank[i] == 0) {
-            continue;
-        }
+void LcpArray::Attach(std::shared_ptr<const void> storage, const uint64_t* values)
+{
+    this->storage = storage;
+    narrow_array = nullptr;
+    wide_array = values;
+}
 
-        auto j = sa[rank[i] - 1];
-        while (sa.EqualTo(i, j, lcp)) {
-            lcp += 1;
+// extends a common prefix of length lcp of the suffixes i and j, 8 bytes at a time
+size_t LcpArray::ExtendMatch(const uint8_t* data, size_t length, size_t i, size_t j, size_t lcp)
+{
+    auto limit = length - std::max(i, j);
+
+    while (lcp + sizeof(uint64_t) <= limit) {
+        uint64_t x, y;
+        std::memcpy(&x, data + i + lcp, sizeof(uint64_t));
+        std::memcpy(&y, data + j + lcp, sizeof(uint64_t));
+        if (x != y) {
+            break;
         }
+        lcp += sizeof(uint64_t);
+    }
+
+    while ((lcp < limit) && (data[i + lcp] == data[j + lcp])) {
+        lcp += 1;
+    }
+
+    return lcp;
+}
 
-        lcp_array[rank[i]] = lcp;
+// same on a packed binary text, 64 symbols at a time
+size_t LcpArray::ExtendMatch(const BitSpan<uint64_t>& bits, size_t i, size_t j, size_t lcp)
+{
+    auto limit = bits.Length() - std::max(i, j);
+
+    while (lcp < limit) {
+        auto x = bits.BitsFrom(i + lcp);
+        auto y = bits.BitsFrom(j + lcp);
+        if (x != y) {
+            lcp += __builtin_clzll(x ^ y);
+            break;
+        }
+        lcp += 64;
     }
 
-    max_lcp = static_cast<size_t>(*std::max_element(lcp_array.begin(), lcp_array.end()));
+    // the zero padding past the end may have matched too
+    return std::min(lcp, limit);
 }
 
-size_t LcpArray::operator[](size_t pos) const
+/**
+ * Phi algorithm: phi[sa[i]] = sa[i - 1] is rewritten in place into the permuted lcp array plcp, 
+ * where plcp[sa[i]] = lcp[i]. Since plcp[i + 1] >= plcp[i] - 1, each thread scans its own range 
+ * of text positions and only restarts from 0 at the beginning of the range.
+ */
+template <typename Index>
+void LcpArray::Build(const SuffixArray& sa, size_t countThreads)
 {
-    return lcp_array[pos];
+    auto data = sa.RawData();
+    auto binary = sa.IsBinary();
+    auto bits = sa.Bits();
+    auto phi = std::vector<Index>(length);
+
+    #pragma omp parallel for num_threads(countThreads)
+    for (size_t i = 0; i < length; ++i) {
+        // length marks the smallest suffix, which has no predecessor
+        phi[sa[i]] = static_cast<Index>((i > 0) ? sa[i - 1] : length);
+    }
+
+    #pragma omp parallel num_threads(countThreads)
+    {
+        size_t tid = omp_get_thread_num();
+        size_t nthreads = omp_get_num_threads();
+        auto begin = length * tid / nthreads;
+        auto end = length * (tid + 1) / nthreads;
+
+        size_t lcp = 0;
+        for (auto i = begin; i < end; ++i) {
+            size_t j = phi[i];
+            if (j == length) {
+                lcp = 0;
+            }
+            else {
+                lcp = binary ? ExtendMatch(bits, i, j, lcp) : ExtendMatch(data, length, i, j, lcp);
+            }
+            phi[i] = static_cast<Index>(lcp);
+            lcp -= (lcp > 0);
+        }
+    }
+
+    auto values = std::make_shared<std::vector<Index>>(length + 1, 0);
+    auto& lcp_array = *values;
+    Index max_value = 0;
+
+    #pragma omp parallel for num_threads(countThreads) reduction(max: max_value)
+    for (size_t i = 0; i < length; ++i) {
+        lcp_array[i] = phi[sa[i]];
+        max_value = std::max(max_value, lcp_array[i]);
+    }
+
+    max_lcp = max_value;
+    Attach(values, values->data());
 }
 
-const std::vector<size_t>& LcpArray::Array() const
+size_t LcpArray::Length() const
 {
-    return lcp_array;
+    return length;
 }
 
 size_t LcpArray::Max() const
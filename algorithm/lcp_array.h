@@ -27,24 +27,52 @@
 
 #include "suffix_array.h"
 
+#include <memory>
+
 namespace randomness { namespace algorithm {
+    /**
+     * lcp[i] is the length of the longest common prefix of the suffixes sa[i - 1] and sa[i], 
+     * with lcp[0] = lcp[Length()] = 0. Values are stored in the same width as the suffix array.
+     */
     class LcpArray {
     private:
+        size_t length;
         size_t max_lcp;
-        std::vector<size_t> lcp_array;
+
+        // owns the values, which are either in memory or in a mapped file
+        std::shared_ptr<const void> storage;
+        const uint32_t* narrow_array = nullptr;
+        const uint64_t* wide_array = nullptr;
 
     public:
-        static LcpArray Create(const SuffixArray& sa);
-        static LcpArray Create(const uint8_t* data, size_t length);
+        static LcpArray Create(const SuffixArray& sa, size_t countThreads = 1);
+        static LcpArray Create(const uint8_t* data, size_t length, size_t countThreads = 1);
 
     private:
-        void Build(const SuffixArray& sa);
+        void Build(const SuffixArray& sa, size_t countThreads);
+
+        template <typename Index>
+        void Build(const SuffixArray& sa, size_t countThreads);
+
+        void Attach(std::shared_ptr<const void> storage, const uint32_t* values);
+        void Attach(std::shared_ptr<const void> storage, const uint64_t* values);
+
+        static size_t ExtendMatch(const uint8_t* data, size_t length, size_t i, size_t j, size_t lcp);
+        static size_t ExtendMatch(const common::BitSpan<uint64_t>& bits, size_t i, size_t j, size_t lcp);
+
+        friend class ExternalLcpBuilder;
+        friend class LcpCache;
 
     public:
         size_t operator[](size_t pos) const;
-        const std::vector<size_t>& Array() const;
+        size_t Length() const;
         size_t Max() const;
     };
+
+    inline size_t LcpArray::operator[](size_t pos) const
+    {
+        return (wide_array == nullptr) ? narrow_array[pos] : wide_array[pos];
+    }
 }}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,202 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lcp_cache.h"
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace randomness::algorithm;
+
+static constexpr char CacheMagic[8] = { 'R', 'N', 'D', 'L', 'C', 'P', 0, 0 };
+static constexpr uint32_t CacheVersion = 2;
+
+struct header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t indexBytes;
+    uint64_t length;
+    uint64_t maxLcp;
+    uint64_t hash;
+};
+
+static uint64_t ContentHash(const uint8_t* data, size_t length)
+{
+    // FNV-1a over 64-bit words, with the high half folded back after each step
+    uint64_t hash = 0xcbf29ce484222325;
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(uint64_t));
+        hash = (hash ^ word) * 0x100000001b3;
+        hash ^= hash >> 32;
+    }
+
+    for (; i < length; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001b3;
+    }
+
+    return hash;
+}
+
+static uint32_t IndexBytes(size_t length)
+{
+    return SuffixArray::IsNarrow(length) ? sizeof(uint32_t) : sizeof(uint64_t);
+}
+
+LcpCache::LcpCache(const std::string& directory) : directory(directory)
+{
+    // an existing directory is fine, and any other failure shows up as a cache miss
+    mkdir(directory.c_str(), 0755);
+}
+
+LcpArray LcpCache::Load(const uint8_t* data, size_t length, size_t countThreads) const
+{
+    auto hash = ContentHash(data, length);
+    auto path = PathOf(hash, length);
+
+    LcpArray lcp;
+    if (TryLoad(path, hash, data, length, lcp)) {
+        return lcp;
+    }
+
+    lcp = LcpArray::Create(data, length, countThreads);
+    Store(path, hash, data, lcp);
+    return lcp;
+}
+
+std::string LcpCache::PathOf(uint64_t hash, size_t length) const
+{
+    char name[64] = {0};
+    std::snprintf(name, sizeof(name), "lcp-%016llx-%llu.bin",
+        static_cast<unsigned long long>(hash), static_cast<unsigned long long>(length));
+
+    return directory + "/" + name;
+}
+
+bool LcpCache::TryLoad(const std::string& path, uint64_t hash, const uint8_t* data, size_t length, LcpArray& lcp) const
+{
+    auto descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat status;
+    auto valid = (fstat(descriptor, &status) == 0) && (static_cast<size_t>(status.st_size) >= sizeof(header_t));
+
+    std::shared_ptr<MappedFile> mapped;
+    if (valid) {
+        mapped = MappedFile::Map(descriptor, status.st_size);
+    }
+    close(descriptor);
+
+    if (valid == false) {
+        return false;
+    }
+
+    auto header = static_cast<const header_t*>(mapped->Data());
+    auto indexBytes = IndexBytes(length);
+    auto values = reinterpret_cast<const uint8_t*>(header + 1);
+    auto valuesBytes = (length + 1) * indexBytes;
+
+    valid = (std::memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) == 0)
+        && (header->version == CacheVersion)
+        && (header->indexBytes == indexBytes)
+        && (header->length == length)
+        && (header->hash == hash)
+        && (mapped->Size() == sizeof(header_t) + valuesBytes + length)
+        && (std::memcmp(values + valuesBytes, data, length) == 0);
+
+    if (valid == false) {
+        return false;
+    }
+
+    lcp.length = length;
+    lcp.max_lcp = header->maxLcp;
+    if (indexBytes == sizeof(uint32_t)) {
+        lcp.Attach(mapped, reinterpret_cast<const uint32_t*>(values));
+    }
+    else {
+        lcp.Attach(mapped, reinterpret_cast<const uint64_t*>(values));
+    }
+
+    return true;
+}
+
+static bool WriteAll(int descriptor, const void* data, size_t size)
+{
+    auto bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        auto written = write(descriptor, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+void LcpCache::Store(const std::string& path, uint64_t hash, const uint8_t* data, const LcpArray& lcp) const
+{
+    header_t header;
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = CacheVersion;
+    header.indexBytes = IndexBytes(lcp.length);
+    header.length = lcp.length;
+    header.maxLcp = lcp.max_lcp;
+    header.hash = hash;
+
+    auto values = (lcp.wide_array == nullptr)
+        ? reinterpret_cast<const char*>(lcp.narrow_array)
+        : reinterpret_cast<const char*>(lcp.wide_array);
+
+    // written aside under a unique name and renamed, so that a reader never maps a partial file
+    auto temporary = path + ".XXXXXX";
+    auto descriptor = mkstemp(&temporary[0]);
+    if (descriptor < 0) {
+        return;
+    }
+
+    auto written = (fchmod(descriptor, 0644) == 0)
+        && WriteAll(descriptor, &header, sizeof(header))
+        && WriteAll(descriptor, values, (lcp.length + 1) * header.indexBytes)
+        && WriteAll(descriptor, data, lcp.length);
+
+    written = (close(descriptor) == 0) && written;
+
+    if (written) {
+        std::rename(temporary.c_str(), path.c_str());
+    }
+    else {
+        std::remove(temporary.c_str());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_ALGORITHM_LCP_CACHE_H__
+#define __RANDOMNESS_ALGORITHM_LCP_CACHE_H__
+
+#include "lcp_array.h"
+
+#include <string>
+
+namespace randomness { namespace algorithm {
+
+    /**
+     * Keeps LCP arrays in a directory, one file per sample named after a hash of its content.
+     * A file holds a small versioned header followed by the raw values, so that a cached array
+     * is mapped into memory as it is, without parsing. The sample itself follows the values, and 
+     * a file is only used when it holds the very same sample, whatever the hash says.
+     */
+    class LcpCache {
+    private:
+        std::string directory;
+
+    public:
+        explicit LcpCache(const std::string& directory);
+
+        // returns the cached array of the sample, building and storing it first if there is none
+        LcpArray Load(const uint8_t* data, size_t length, size_t countThreads = 1) const;
+
+    private:
+        std::string PathOf(uint64_t hash, size_t length) const;
+
+        bool TryLoad(const std::string& path, uint64_t hash, const uint8_t* data, size_t length, LcpArray& lcp) const;
+        void Store(const std::string& path, uint64_t hash, const uint8_t* data, const LcpArray& lcp) const;
+    };
+}}
+
+#endif
\ No newline at end of file
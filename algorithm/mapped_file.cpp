@@ -0,0 +1,67 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#include <sys/mman.h>
+
+using namespace randomness::algorithm;
+
+std::shared_ptr<MappedFile> MappedFile::Map(int descriptor, size_t size)
+{
+    void* address = nullptr;
+
+    // an empty mapping is not allowed, so an empty file maps to nullptr
+    if (size > 0) {
+        address = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("mmap failed");
+        }
+    }
+
+    return std::shared_ptr<MappedFile>(new MappedFile(address, size));
+}
+
+MappedFile::MappedFile(void* address, size_t size) : address(address), size(size)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    if (address != nullptr) {
+        munmap(address, size);
+    }
+}
+
+const void* MappedFile::Data() const
+{
+    return address;
+}
+
+size_t MappedFile::Size() const
+{
+    return size;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_ALGORITHM_MAPPED_FILE_H__
+#define __RANDOMNESS_ALGORITHM_MAPPED_FILE_H__
+
+#include <cstddef>
+#include <memory>
+
+namespace randomness { namespace algorithm {
+
+    /**
+     * Read-only memory mapping of a file. The mapping stays valid after the descriptor is closed.
+     */
+    class MappedFile {
+    private:
+        void* address;
+        size_t size;
+
+    public:
+        static std::shared_ptr<MappedFile> Map(int descriptor, size_t size);
+
+    private:
+        MappedFile(void* address, size_t size);
+
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const void* Data() const;
+        size_t Size() const;
+    };
+}}
+
+#endif
\ No newline at end of file
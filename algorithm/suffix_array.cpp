@@ -25,60 +25,471 @@
 #include "suffix_array.h"
 
 #include <algorithm>
-#include <cstring>
+
+#include <omp.h>
 
 using namespace randomness::algorithm;
+using namespace randomness::common;
+
+static constexpr size_t ThresholdNaive = 10;
 
-bool randomness::algorithm::operator<(const suffix_t& lhs, const suffix_t& rhs)
+template <typename Char, typename Index>
+static std::vector<Index> SortNaive(const Char* s, size_t n)
 {
-    const uint8_t* lptr = lhs.suffix;
-    const uint8_t* rptr = rhs.suffix;
+    std::vector<Index> sa(n);
+    for (size_t i = 0; i < n; ++i) {
+        sa[i] = static_cast<Index>(i);
+    }
+
+    std::sort(sa.begin(), sa.end(), [&](Index l, Index r) {
+        return std::lexicographical_compare(s + l, s + n, s + r, s + n);
+    });
+
+    return sa;
+}
+
+/**
+ * SA-IS: G. Nong, S. Zhang and W. H. Chan, "Two Efficient Algorithms for Linear Time Suffix Array Construction".
+ * Sorts the suffixes of s[0..n) whose symbols are in [0, upper] in O(n) time, a proper prefix being the smaller one.
+ * Based on the implementation in the AtCoder Library.
+ */
+template <typename Char, typename Index>
+static std::vector<Index> SuffixArrayInducedSorting(const Char* s, size_t n, size_t upper)
+{
+    constexpr Index Empty = static_cast<Index>(-1);
+
+    if (n < ThresholdNaive) {
+        return SortNaive<Char, Index>(s, n);
+    }
+
+    // ls[i] is true when the suffix i is S-type, i.e. smaller than the suffix i + 1
+    std::vector<bool> ls(n, false);
+    for (size_t i = n - 1; i-- > 0; ) {
+        ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    std::vector<Index> sum_l(upper + 1, 0);
+    std::vector<Index> sum_s(upper + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        if (ls[i] == false) {
+            sum_s[s[i]] += 1;
+        }
+        else {
+            sum_l[s[i] + 1] += 1;
+        }
+    }
+    for (size_t i = 0; i <= upper; ++i) {
+        sum_s[i] += sum_l[i];
+        if (i < upper) {
+            sum_l[i + 1] += sum_s[i];
+        }
+    }
+
+    std::vector<Index> sa(n);
+    std::vector<Index> bucket(upper + 1);
+
+    auto induce = [&](const std::vector<Index>& lms) {
+        std::fill(sa.begin(), sa.end(), Empty);
+
+        std::copy(sum_s.begin(), sum_s.end(), bucket.begin());
+        for (auto d : lms) {
+            sa[bucket[s[d]]++] = d;
+        }
+
+        std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+        sa[bucket[s[n - 1]]++] = static_cast<Index>(n - 1);
+        for (size_t i = 0; i < n; ++i) {
+            auto v = sa[i];
+            if ((v != Empty) && (v >= 1) && (ls[v - 1] == false)) {
+                sa[bucket[s[v - 1]]++] = v - 1;
+            }
+        }
+
+        std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+        for (size_t i = n; i-- > 0; ) {
+            auto v = sa[i];
+            if ((v != Empty) && (v >= 1) && ls[v - 1]) {
+                sa[--bucket[s[v - 1] + 1]] = v - 1;
+            }
+        }
+    };
+
+    // leftmost S-type positions, numbered from left to right
+    std::vector<Index> lms_map(n + 1, Empty);
+    std::vector<Index> lms;
+    for (size_t i = 1; i < n; ++i) {
+        if ((ls[i - 1] == false) && ls[i]) {
+            lms_map[i] = static_cast<Index>(lms.size());
+            lms.push_back(static_cast<Index>(i));
+        }
+    }
+    auto m = lms.size();
+
+    induce(lms);
+
+    if (m == 0) {
+        return sa;
+    }
+
+    std::vector<Index> sorted_lms;
+    sorted_lms.reserve(m);
+    for (auto v : sa) {
+        if (lms_map[v] != Empty) {
+            sorted_lms.push_back(v);
+        }
+    }
 
-    int64_t cmp = memcmp(lptr, rptr, std::min(lhs.length, rhs.length));
-    if (cmp == 0) {
-        cmp = static_cast<int64_t>(lhs.length) - static_cast<int64_t>(rhs.length);
+    // name the LMS substrings by their rank and sort the reduced string recursively
+    std::vector<Index> rec_s(m);
+    size_t rec_upper = 0;
+    rec_s[lms_map[sorted_lms[0]]] = 0;
+    for (size_t i = 1; i < m; ++i) {
+        size_t l = sorted_lms[i - 1];
+        size_t r = sorted_lms[i];
+        size_t end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+        size_t end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+
+        auto same = true;
+        if (end_l - l != end_r - r) {
+            same = false;
+        }
+        else {
+            while ((l < end_l) && (s[l] == s[r])) {
+                ++l;
+                ++r;
+            }
+            if ((l == n) || (s[l] != s[r])) {
+                same = false;
+            }
+        }
+
+        if (same == false) {
+            rec_upper += 1;
+        }
+        rec_s[lms_map[sorted_lms[i]]] = static_cast<Index>(rec_upper);
+    }
+
+    auto rec_sa = SuffixArrayInducedSorting<Index, Index>(rec_s.data(), m, rec_upper);
+    for (size_t i = 0; i < m; ++i) {
+        sorted_lms[i] = lms[rec_sa[i]];
     }
 
-    return cmp < 0;
+    induce(sorted_lms);
+
+    return sa;
+}
+
+static constexpr size_t RadixBits = 8;
+static constexpr size_t RadixBuckets = 1 << RadixBits;
+
+// stable LSD radix sort of (key, value) pairs on the lowest keyBits bits of the keys
+template <typename Index>
+static void RadixSort(std::vector<uint64_t>& keys, std::vector<Index>& values, size_t keyBits, size_t countThreads)
+{
+    auto n = keys.size();
+    auto tmp_keys = std::vector<uint64_t>(n);
+    auto tmp_values = std::vector<Index>(n);
+    auto histogram = std::vector<size_t>(countThreads * RadixBuckets);
+
+    for (size_t shift = 0; shift < keyBits; shift += RadixBits) {
+        #pragma omp parallel num_threads(countThreads)
+        {
+            size_t tid = omp_get_thread_num();
+            size_t nthreads = omp_get_num_threads();
+            auto begin = n * tid / nthreads;
+            auto end = n * (tid + 1) / nthreads;
+            auto counts = histogram.data() + tid * RadixBuckets;
+
+            std::fill(counts, counts + RadixBuckets, 0);
+            for (auto i = begin; i < end; ++i) {
+                counts[(keys[i] >> shift) & (RadixBuckets - 1)] += 1;
+            }
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                size_t offset = 0;
+                for (size_t d = 0; d < RadixBuckets; ++d) {
+                    for (size_t t = 0; t < nthreads; ++t) {
+                        auto count = histogram[t * RadixBuckets + d];
+                        histogram[t * RadixBuckets + d] = offset;
+                        offset += count;
+                    }
+                }
+            }
+
+            for (auto i = begin; i < end; ++i) {
+                auto pos = counts[(keys[i] >> shift) & (RadixBuckets - 1)]++;
+                tmp_keys[pos] = keys[i];
+                tmp_values[pos] = values[i];
+            }
+        }
+
+        keys.swap(tmp_keys);
+        values.swap(tmp_values);
+    }
 }
 
-static std::vector<suffix_t> BuildSuffixStructure(const uint8_t* str, size_t length) 
+// ranks the sorted keys densely, equal keys sharing a rank, and returns the largest rank
+template <typename Index>
+static uint64_t Rename(const std::vector<uint64_t>& keys, const std::vector<Index>& sa, std::vector<Index>& rank, size_t countThreads)
 {
-    std::vector<suffix_t> suffixes(length);
+    auto n = keys.size();
+    auto distinct = std::vector<size_t>(countThreads + 1, 0);
+
+    rank[sa[0]] = 0;
+
+    #pragma omp parallel num_threads(countThreads)
+    {
+        size_t tid = omp_get_thread_num();
+        size_t nthreads = omp_get_num_threads();
+        auto begin = std::max<size_t>(n * tid / nthreads, 1);
+        auto end = n * (tid + 1) / nthreads;
+
+        size_t count = 0;
+        for (auto i = begin; i < end; ++i) {
+            count += (keys[i] != keys[i - 1]);
+        }
+        distinct[tid + 1] = count;
 
-    for (size_t i = 0; i < length; ++i) {
-        suffixes[i].index = i;
-        suffixes[i].suffix = str + i;
-        suffixes[i].length = length - i;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (size_t t = 1; t <= nthreads; ++t) {
+                distinct[t] += distinct[t - 1];
+            }
+        }
+
+        auto current = distinct[tid];
+        for (auto i = begin; i < end; ++i) {
+            current += (keys[i] != keys[i - 1]);
+            rank[sa[i]] = static_cast<Index>(current);
+        }
     }
 
-    return suffixes;
+    return rank[sa[n - 1]];
 }
 
-SuffixArray SuffixArray::Create(const uint8_t* str, size_t length)
+static size_t BitLength(uint64_t value)
+{
+    size_t bits = 0;
+    while ((bits < 64) && (value >> bits) > 0) {
+        bits += 1;
+    }
+    return bits;
+}
+
+/**
+ * Prefix doubling: suffixes are first ranked by as many leading symbols as fit in 32 bits, 
+ * then each round radix sorts the pairs (rank[i], rank[i + h]) and renames them to rank by 2h symbols.
+ * Sorting and renaming are done in parallel.
+ */
+template <typename Index>
+static std::vector<Index> SuffixArrayPrefixDoubling(const uint8_t* s, size_t n, size_t countThreads)
+{
+    auto sa = std::vector<Index>(n);
+    auto rank = std::vector<Index>(n);
+    auto keys = std::vector<uint64_t>(n);
+
+    if (n == 0) {
+        return sa;
+    }
+
+    // symbols are shifted by one so that 0 pads the suffixes shorter than h
+    auto symbolBits = BitLength(*std::max_element(s, s + n) + 1);
+    auto h = 32 / symbolBits;
+
+    #pragma omp parallel for num_threads(countThreads)
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t key = 0;
+        for (size_t j = 0; j < h; ++j) {
+            key = (key << symbolBits) | ((i + j < n) ? s[i + j] + 1 : 0);
+        }
+        keys[i] = key;
+        sa[i] = static_cast<Index>(i);
+    }
+
+    RadixSort(keys, sa, h * symbolBits, countThreads);
+    auto max_rank = Rename(keys, sa, rank, countThreads);
+
+    for (; max_rank < n - 1; h <<= 1) {
+        // rank 0 of the second half is reserved for suffixes shorter than h
+        auto radix = max_rank + 2;
+
+        #pragma omp parallel for num_threads(countThreads)
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rank[i] * radix + ((i + h < n) ? rank[i + h] + 1 : 0);
+            sa[i] = static_cast<Index>(i);
+        }
+
+        RadixSort(keys, sa, BitLength(radix * radix - 1), countThreads);
+        max_rank = Rename(keys, sa, rank, countThreads);
+    }
+
+    return sa;
+}
+
+static constexpr size_t BucketBits = 16;
+
+// suffixes sharing this many leading words are left to the general sorters
+static constexpr size_t PrefixWords = 4;
+
+/**
+ * Orders binary suffixes by their first PrefixWords * 64 symbols, 64 symbols per comparison. 
+ * Returns -1, 0 or 1, where 0 means the suffixes could not be told apart within the prefix.
+ */
+static int CompareBinarySuffixes(const BitSpan<uint64_t>& bits, size_t i, size_t j)
+{
+    auto n = bits.Length();
+
+    for (size_t offset = 0; offset < PrefixWords * 64; offset += 64) {
+        auto x = bits.BitsFrom(i + offset);
+        auto y = bits.BitsFrom(j + offset);
+        if (x != y) {
+            return (x < y) ? -1 : 1;
+        }
+
+        // equal words with zero padding: the suffix ending first is a prefix of the other
+        if ((n - i <= offset + 64) || (n - j <= offset + 64)) {
+            return (i > j) ? -1 : (i < j) ? 1 : 0;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Sorts binary suffixes on the packed text: the suffixes are distributed by their first 
+ * BucketBits symbols and each bucket is sorted with word comparisons. This is only worth it when 
+ * the text has no long repeats, so it gives up when a bucket is too large or two suffixes share 
+ * the whole compared prefix, and returns false.
+ */
+static bool SuffixArrayBinaryPacked(const BitSpan<uint64_t>& bits, std::vector<uint32_t>& sa, size_t countThreads)
+{
+    auto n = bits.Length();
+    auto offsets = std::vector<size_t>((1 << BucketBits) + 1, 0);
+
+    for (size_t i = 0; i < n; ++i) {
+        offsets[(bits.BitsFrom(i) >> (64 - BucketBits)) + 1] += 1;
+    }
+
+    for (size_t b = 1; b < offsets.size(); ++b) {
+        if (offsets[b] > (n >> 6) + 64) {
+            return false;
+        }
+        offsets[b] += offsets[b - 1];
+    }
+
+    sa.resize(n);
+    auto next = offsets;
+    for (size_t i = 0; i < n; ++i) {
+        sa[next[bits.BitsFrom(i) >> (64 - BucketBits)]++] = static_cast<uint32_t>(i);
+    }
+
+    using entry_t = std::pair<uint64_t, uint32_t>;
+
+    auto less = [&bits](const entry_t& x, const entry_t& y) { 
+        if (x.first != y.first) {
+            return x.first < y.first;
+        }
+        return CompareBinarySuffixes(bits, x.second, y.second) < 0; 
+    };
+
+    auto resolved = true;
+    auto countBuckets = static_cast<int64_t>(offsets.size() - 1);
+
+    #pragma omp parallel num_threads(countThreads) reduction(&&: resolved)
+    {
+        auto bucket = std::vector<entry_t>();
+        auto sorted = std::vector<entry_t>();
+        auto counts = std::vector<size_t>(RadixBuckets + 1);
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int64_t b = 0; b < countBuckets; ++b) {
+            // the first word decides almost every comparison, so it is loaded only once per suffix
+            bucket.clear();
+            for (auto k = offsets[b]; k < offsets[b + 1]; ++k) {
+                bucket.emplace_back(bits.BitsFrom(sa[k]), sa[k]);
+            }
+
+            // distributing by the next RadixBits symbols leaves only a few suffixes to compare
+            auto shift = 64 - BucketBits - RadixBits;
+            std::fill(counts.begin(), counts.end(), 0);
+            for (auto& entry : bucket) {
+                counts[((entry.first >> shift) & (RadixBuckets - 1)) + 1] += 1;
+            }
+            for (size_t d = 1; d <= RadixBuckets; ++d) {
+                counts[d] += counts[d - 1];
+            }
+
+            sorted.resize(bucket.size());
+            for (auto& entry : bucket) {
+                sorted[counts[(entry.first >> shift) & (RadixBuckets - 1)]++] = entry;
+            }
+
+            // the comparison is a weak order, so that undecided suffixes are merely kept together
+            for (size_t d = 0, begin = 0; d < RadixBuckets; begin = counts[d++]) {
+                if (counts[d] - begin > 1) {
+                    std::sort(sorted.begin() + begin, sorted.begin() + counts[d], less);
+                }
+            }
+
+            for (size_t k = 0; k < sorted.size(); ++k) {
+                sa[offsets[b] + k] = sorted[k].second;
+
+                if ((k > 0) && (sorted[k - 1].first == sorted[k].first) && CompareBinarySuffixes(bits, sorted[k - 1].second, sorted[k].second) == 0) {
+                    resolved = false;
+                }
+            }
+        }
+    }
+
+    return resolved;
+}
+
+SuffixArray SuffixArray::Create(const uint8_t* str, size_t length, size_t countThreads)
 {
     SuffixArray sa;
-    sa.Build(str, length);
+    sa.Build(str, length, countThreads);
     return sa;
 }
 
-void SuffixArray::Build(const uint8_t* str, size_t length)
+void SuffixArray::Build(const uint8_t* str, size_t length, size_t countThreads)
 {
     data = str;
     this->length = length;
 
-    suffix_array = BuildSuffixStructure(str, length);
-    std::sort(suffix_array.begin(), suffix_array.end());
-}
+    narrow_array.clear();
+    wide_array.clear();
+    packed_data.clear();
 
-size_t SuffixArray::operator[](size_t pos) const
-{
-    return suffix_array[pos].index;
+    if (std::all_of(str, str + length, [](uint8_t symbol) { return symbol <= 1; })) {
+        packed_data.assign((length + 63) / 64, 0);
+        for (size_t i = 0; i < length; ++i) {
+            packed_data[i / 64] |= static_cast<uint64_t>(str[i]) << (63 - i % 64);
+        }
+
+        if (IsNarrow(length) && SuffixArrayBinaryPacked(Bits(), narrow_array, countThreads)) {
+            return;
+        }
+        narrow_array.clear();
+    }
+
+    if (IsNarrow(length) && (countThreads > 1)) {
+        narrow_array = SuffixArrayPrefixDoubling<uint32_t>(str, length, countThreads);
+    }
+    else if (IsNarrow(length)) {
+        narrow_array = SuffixArrayInducedSorting<uint8_t, uint32_t>(str, length, UINT8_MAX);
+    }
+    else {
+        wide_array = SuffixArrayInducedSorting<uint8_t, uint64_t>(str, length, UINT8_MAX);
+    }
 }
 
-const std::vector<suffix_t>& SuffixArray::Array() const
+bool SuffixArray::IsNarrow(size_t length)
 {
-    return suffix_array;
+    // the largest value of the index type marks an empty slot while sorting
+    return length < UINT32_MAX;
 }
 
 const uint8_t* SuffixArray::RawData() const
@@ -86,6 +497,16 @@ const uint8_t* SuffixArray::RawData() const
     return data;
 }
 
+bool SuffixArray::IsBinary() const
+{
+    return (length > 0) && (packed_data.empty() == false);
+}
+
+BitSpan<uint64_t> SuffixArray::Bits() const
+{
+    return BitSpan<uint64_t>(packed_data.data(), length);
+}
+
 size_t SuffixArray::Length() const
 {
     return length;
@@ -25,42 +25,54 @@
 #ifndef __RANDOMNESS_ALGORITHM_SUFFIX_ARRAY_H__
 #define __RANDOMNESS_ALGORITHM_SUFFIX_ARRAY_H__
 
+#include "../common/bit_span.h"
+
 #include <cstdint>
 #include <vector>
 
 namespace randomness { namespace algorithm {
 
-    struct suffix_t {
-        size_t index;
-        size_t length;
-        const uint8_t* suffix;
-
-        friend bool operator<(const suffix_t& lhs, const suffix_t& rhs);
-    };
-
-    bool operator<(const suffix_t& lhs, const suffix_t& rhs);
-
+    /**
+     * Suffix positions are stored in 32 bits whenever the length allows it, and in 64 bits otherwise.
+     */
     class SuffixArray {
     private:
         const uint8_t* data;
         size_t length;
-        std::vector<suffix_t> suffix_array;
+        std::vector<uint32_t> narrow_array;
+        std::vector<uint64_t> wide_array;
+
+        // binary text packed 64 symbols per word, empty for other alphabets
+        std::vector<uint64_t> packed_data;
         
     public:
-        static SuffixArray Create(const uint8_t* str, size_t length);
+        /**
+         * Sorts with SA-IS when countThreads is 1, and with a parallel prefix doubling on 
+         * countThreads threads otherwise. Binary texts are first tried on the packed text. 
+         * All of them give the same array.
+         */
+        static SuffixArray Create(const uint8_t* str, size_t length, size_t countThreads = 1);
+        static bool IsNarrow(size_t length);
 
     private:
-        void Build(const uint8_t* str, size_t length);
+        void Build(const uint8_t* str, size_t length, size_t countThreads);
 
     public:
         size_t operator[](size_t pos) const;
         
-        const std::vector<suffix_t>& Array() const;
         const uint8_t* RawData() const;
+        bool IsBinary() const;
+        common::BitSpan<uint64_t> Bits() const;
         size_t Length() const;
 
         bool EqualTo(size_t i, size_t j, size_t offset) const;
     };
+
+    // read on every step of the LCP, t-Tuple and LRS passes, where the width never changes and the branch is always predicted
+    inline size_t SuffixArray::operator[](size_t pos) const
+    {
+        return wide_array.empty() ? narrow_array[pos] : wide_array[pos];
+    }
 }}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_COMMON_BIT_SPAN_H__
+#define __RANDOMNESS_COMMON_BIT_SPAN_H__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace randomness { namespace common {
+
+    /**
+     * Non-owning view of a bit sequence packed into words, most significant bit first. 
+     * The first bit of the sequence is the most significant bit of the first word.
+     */
+    template <typename Word>
+    class BitSpan 
+    {
+    public:
+        static constexpr size_t WordBits = sizeof(Word) * 8;
+
+    private:
+        const Word* words;
+        size_t length;
+
+    public:
+        BitSpan(const Word* words, size_t lengthInBits) : words(words), length(lengthInBits) {}
+
+        size_t Length() const
+        {
+            return length;
+        }
+
+        size_t CountWords() const
+        {
+            return (length + WordBits - 1) / WordBits;
+        }
+
+        size_t ValidBits(size_t index) const
+        {
+            auto offset = index * WordBits;
+            return (length - offset < WordBits) ? length - offset : WordBits;
+        }
+
+        // index-th word with the bits past the end of the sequence cleared
+        Word WordAt(size_t index) const
+        {
+            auto valid = ValidBits(index);
+            if (valid == WordBits) {
+                return words[index];
+            }
+
+            return words[index] & static_cast<Word>(~static_cast<uint64_t>(0) << (WordBits - valid));
+        }
+
+        // WordBits bits starting at bit pos, with the bits past the end of the sequence cleared
+        Word BitsFrom(size_t pos) const
+        {
+            if (pos >= length) {
+                return 0;
+            }
+
+            auto index = pos / WordBits;
+            auto shift = pos % WordBits;
+
+            auto word = static_cast<Word>(WordAt(index) << shift);
+            if ((shift > 0) && (index + 1 < CountWords())) {
+                word |= static_cast<Word>(WordAt(index + 1) >> (WordBits - shift));
+            }
+            return word;
+        }
+
+        uint8_t BitAt(size_t pos) const
+        {
+            return (words[pos / WordBits] >> (WordBits - 1 - (pos % WordBits))) & 0x1;
+        }
+
+        size_t HammingWeight(size_t offset, size_t count) const
+        {
+            size_t hw = 0;
+
+            while ((count > 0) && (offset % WordBits != 0)) {
+                hw += BitAt(offset++);
+                count -= 1;
+            }
+
+            for (; count >= WordBits; offset += WordBits, count -= WordBits) {
+                hw += __builtin_popcountll(words[offset / WordBits]);
+            }
+
+            while (count > 0) {
+                hw += BitAt(offset++);
+                count -= 1;
+            }
+
+            return hw;
+        }
+    };
+}}
+
+#endif
\ No newline at end of file
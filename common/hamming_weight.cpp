@@ -69,7 +69,7 @@ static inline size_t HammingWeightOctal(const Sample& sample, size_t offset, siz
 {
     size_t hw = 0;
 
-    auto data = sample.OctalData();
+    auto& data = sample.OctalData();
     for (auto i = offset; i < offset + length; ++i) {
         hw += HammingTable[data[i]];
     }
@@ -81,7 +81,7 @@ static inline size_t HammingWeightBinary(const Sample& sample, size_t offset, si
 {
     size_t hw = 0;
     
-    auto data = sample.BinaryData();
+    auto& data = sample.BinaryData();
     for (auto i = offset; i < offset + length; ++i) {
         hw += data[i];
     }
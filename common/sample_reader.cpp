@@ -84,9 +84,9 @@ SharePtrSample SampleReader::NextBytes(size_t length)
     auto pbuf = reinterpret_cast<const uint8_t*>(buffer);
 
     while (length > 0) {
-        auto read = ReadChunk(buffer);
-        if (read > length) {
-            read = length;
+        auto read = ReadChunk(buffer, length);
+        if (read == 0) {
+            break;
         }
 
         sample->AppendBytes(pbuf, read);
@@ -96,18 +96,29 @@ SharePtrSample SampleReader::NextBytes(size_t length)
     return sample;
 }
 
-size_t SampleReader::ReadChunk(char* buffer)
+size_t SampleReader::ReadChunk(char* buffer, size_t limit)
 {
     auto curr = ifs.tellg();
     ifs.seekg(0, std::ios::end);
-    auto length = ifs.tellg() - curr;
+    auto remains = ifs.tellg() - curr;
     
     ifs.seekg(curr, std::ios::beg);
 
+    // a failed tellg() gives -1, which must not turn into a huge unsigned length
+    if (remains <= 0) {
+        return 0;
+    }
+
+    auto length = static_cast<size_t>(remains);
     if (length > ChunkSize) {
         length = ChunkSize;
     }
 
+    // never read past the requested length, the rest belongs to the next call
+    if (length > limit) {
+        length = limit;
+    }
+
     ifs.read(buffer, length);
 
     return length;
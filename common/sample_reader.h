@@ -49,7 +49,7 @@ namespace randomness { namespace common {
         SharePtrSample NextBytes(size_t length);
 
     private:
-        size_t ReadChunk(char* buffer);
+        size_t ReadChunk(char* buffer, size_t limit);
     };
 }}
 
@@ -0,0 +1,99 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "block_frequency_monitor.h"
+
+#include "../common/hamming_weight.h"
+
+using namespace randomness::sp800_22;
+using namespace randomness::common;
+
+BlockFrequencyMonitor::BlockFrequencyMonitor(size_t windowLengthInBits) : blockBytes(blockLength >> 3)
+{
+    if ((windowLengthInBits % blockLength) != 0 || windowLengthInBits < MinimumLengthInBits()) {
+        throw std::invalid_argument("invalid window length");
+    }
+
+    recentOnes.assign(blockBytes, 0);
+    blocks.assign(blockBytes, SlidingWindow<uint16_t>(windowLengthInBits / blockLength));
+    squaredDeviations.assign(blockBytes, 0);
+}
+
+// the weight of the block ending at each byte is rolled over the last M / 8 bytes
+void BlockFrequencyMonitor::Push(uint8_t word)
+{
+    auto slot = countPushed % blockBytes;
+    auto hw = HammingWeight(word);
+
+    blockOnes = blockOnes + hw - recentOnes[slot];
+    recentOnes[slot] = hw;
+    countPushed += 1;
+
+    if (countPushed < blockBytes) {
+        return;
+    }
+
+    uint16_t evicted = 0;
+    if (blocks[slot].Push(blockOnes, evicted)) {
+        squaredDeviations[slot] -= SquaredDeviation(evicted);
+    }
+    squaredDeviations[slot] += SquaredDeviation(blockOnes);
+}
+
+void BlockFrequencyMonitor::Push(const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        Push(data[i]);
+    }
+}
+
+size_t BlockFrequencyMonitor::LengthInBits() const
+{
+    return (countPushed == 0) ? 0 : blocks[Phase()].Size() * blockLength;
+}
+
+std::vector<randomness_result_t> BlockFrequencyMonitor::EvaluateWindow()
+{
+    logstream.str("");
+    if (countPushed < blockBytes) {
+        return {};
+    }
+
+    // (hw / M - 1/2)² = (2hw - M)² / 4M², kept as an integer so that evicting a block is exact
+    auto phase = Phase();
+    auto squaredSum = squaredDeviations[phase] / (4.0 * blockLength * blockLength);
+
+    return Conclude(blocks[phase].Size(), squaredSum);
+}
+
+uint64_t BlockFrequencyMonitor::SquaredDeviation(size_t hw) const
+{
+    auto deviation = static_cast<int64_t>(2 * hw) - static_cast<int64_t>(blockLength);
+    return deviation * deviation;
+}
+
+size_t BlockFrequencyMonitor::Phase() const
+{
+    return (countPushed - 1) % blockBytes;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_22_BLOCK_FREQUENCY_MONITOR_H__
+#define __RANDOMNESS_SP800_22_BLOCK_FREQUENCY_MONITOR_H__
+
+#include "block_frequency_test.h"
+#include "sliding_window.h"
+
+#include <vector>
+
+namespace randomness { namespace sp800_22 {
+
+    /**
+     * Frequency test within a block over the last W bits of a stream, split into W / M blocks 
+     * ending at the newest byte, and updated in O(1) per pushed byte. The blocks ending at each 
+     * byte offset modulo M / 8 are kept apart, so that the window can end at any byte.
+     */
+    class BlockFrequencyMonitor : public BlockFrequencyTest 
+    {
+    private:
+        size_t blockBytes;
+        size_t countPushed = 0;
+        size_t blockOnes = 0;
+        std::vector<uint8_t> recentOnes;
+
+        std::vector<SlidingWindow<uint16_t>> blocks;
+        std::vector<uint64_t> squaredDeviations;
+
+    public:
+        BlockFrequencyMonitor(size_t windowLengthInBits);
+
+        void Push(uint8_t word);
+        void Push(const uint8_t* data, size_t length);
+
+        size_t LengthInBits() const;
+
+        // no results until the first block is complete
+        std::vector<randomness_result_t> EvaluateWindow();
+
+    private:
+        uint64_t SquaredDeviation(size_t hw) const;
+
+        // the blocks ending at the newest byte
+        size_t Phase() const;
+    };
+}}
+
+#endif
\ No newline at end of file
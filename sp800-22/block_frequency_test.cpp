@@ -45,25 +45,101 @@ size_t BlockFrequencyTest::MinimumLengthInBits() const
     return 100;
 }
 
-static double CalculateStatistic(const Sample& sample, size_t blockLength, size_t countBlocks)
+static inline double SquaredDeviation(size_t hw, size_t blockLength)
+{
+    auto pi = hw / static_cast<double>(blockLength);
+    return (pi - 0.5) * (pi - 0.5);
+}
+
+static double CalculateSquaredSum(const Sample& sample, size_t blockLength, size_t countBlocks)
 {
     double squared_sum = 0;
     for (auto i = 0; i < countBlocks; ++i) {
         auto hw = HammingWeight(sample, i * blockLength, blockLength);
-        auto pi = hw / static_cast<double>(blockLength);
-        squared_sum += (pi - 0.5) * (pi - 0.5);
+        squared_sum += SquaredDeviation(hw, blockLength);
+    }
+
+    return squared_sum;
+}
+
+template <typename Word>
+static double CalculateSquaredSum(const BitSpan<Word>& bits, size_t blockLength, size_t countBlocks)
+{
+    double squared_sum = 0;
+    for (size_t i = 0; i < countBlocks; ++i) {
+        auto hw = bits.HammingWeight(i * blockLength, blockLength);
+        squared_sum += SquaredDeviation(hw, blockLength);
     }
-    auto chisquare = 4 * blockLength * squared_sum;
 
-    return chisquare;
+    return squared_sum;
+}
+
+static inline double CalculatePValue(size_t countBlocks, double chisquare)
+{
+    return igammac(countBlocks/2.0, chisquare/2.0);
+}
+
+template <typename Word>
+static double CalculatePValue(const BitSpan<Word>& bits, size_t blockLength)
+{
+    auto countBlocks = bits.Length() / blockLength;
+    auto chisquare = 4 * blockLength * CalculateSquaredSum(bits, blockLength, countBlocks);
+
+    return CalculatePValue(countBlocks, chisquare);
 }
 
 std::vector<randomness_result_t> BlockFrequencyTest::Evaluate(const Sample& sample)
 {
     blockLength = 128;    
     auto countBlocks = sample.BinaryData().size() / blockLength;
-    auto chisquare = CalculateStatistic(sample, blockLength, countBlocks);
-    auto pvalue = igammac(countBlocks/2.0, chisquare/2.0);
+    auto squared_sum = CalculateSquaredSum(sample, blockLength, countBlocks);
+
+    return Conclude(countBlocks, squared_sum);
+}
+
+void BlockFrequencyTest::Begin(size_t)
+{
+    blockLength = 128;
+    countBlocks = 0;
+    blockOnes = 0;
+    blockFill = 0;
+    squaredSum = 0;
+}
+
+void BlockFrequencyTest::Accumulate(const Sample& chunk)
+{
+    for (auto bit : chunk.BinaryData()) {
+        blockOnes += bit;
+
+        if (++blockFill == blockLength) {
+            squaredSum += SquaredDeviation(blockOnes, blockLength);
+            countBlocks += 1;
+
+            blockOnes = 0;
+            blockFill = 0;
+        }
+    }
+}
+
+std::vector<randomness_result_t> BlockFrequencyTest::Finalize()
+{
+    return Conclude(countBlocks, squaredSum);
+}
+
+double BlockFrequencyTest::PValue(const BitSpan<uint8_t>& bits) const
+{
+    return CalculatePValue(bits, blockLength);
+}
+
+double BlockFrequencyTest::PValue(const BitSpan<uint64_t>& bits) const
+{
+    return CalculatePValue(bits, blockLength);
+}
+
+std::vector<randomness_result_t> BlockFrequencyTest::Conclude(size_t countBlocks, double squaredSum)
+{
+    auto chisquare = 4 * blockLength * squaredSum;
+    auto pvalue = CalculatePValue(countBlocks, chisquare);
 
     auto result = std::vector<randomness_result_t>{};
     result.push_back(randomness_result_t {Name(), ShortName(), "m = 128", pvalue});
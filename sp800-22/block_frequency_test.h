@@ -31,14 +31,30 @@ namespace randomness { namespace sp800_22 {
     
     class BlockFrequencyTest : public StatisticalTest 
     {
+    protected:
+        size_t blockLength = 128;
+
     private:
-        size_t blockLength;
+        size_t countBlocks;
+        size_t blockOnes;
+        size_t blockFill;
+        double squaredSum;
 
     public:
         const std::string Name() const override;
         const std::string ShortName() const override;
         size_t MinimumLengthInBits() const override;
         std::vector<randomness_result_t> Evaluate(const Sample& sample) override;
+
+        void Begin(size_t lengthInBits) override;
+        void Accumulate(const Sample& chunk) override;
+        std::vector<randomness_result_t> Finalize() override;
+
+        double PValue(const BitSpan<uint8_t>& bits) const override;
+        double PValue(const BitSpan<uint64_t>& bits) const override;
+
+    protected:
+        std::vector<randomness_result_t> Conclude(size_t countBlocks, double squaredSum);
     };
 }}
 
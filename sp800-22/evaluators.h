@@ -30,4 +30,8 @@
 #include "runs_test.h"
 #include "longest_run_test.h"
 
+#include "monobit_monitor.h"
+#include "block_frequency_monitor.h"
+#include "runs_monitor.h"
+
 #endif
\ No newline at end of file
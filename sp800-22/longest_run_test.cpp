@@ -13,6 +13,78 @@ static constexpr size_t RANGE3[] = { 1, 2, 3, 4 };
 static constexpr size_t RANGE5[] = { 4, 5, 6, 7, 8, 9 };
 static constexpr size_t RANGE6[] = { 10, 11, 12, 13, 14, 15, 16 };
 
+static constexpr size_t MaxDof = 6;
+
+typedef struct {
+    size_t blockLength;
+    size_t dof;
+    const double* pi;
+    const size_t* range;
+} parameter_t;
+
+static parameter_t SelectParameters(size_t length)
+{
+    if (length < 128) {
+        throw std::invalid_argument("sample length is too short");
+    }
+    else if (length < 6272) {
+        return parameter_t {8, 3, PI3, RANGE3};
+    }
+    else if (length < 750000) {
+        return parameter_t {128, 5, PI5, RANGE5};
+    }
+
+    return parameter_t {10000, 6, PI6, RANGE6};
+}
+
+static inline size_t FrequencyIndex(size_t longest, size_t dof, const size_t* range)
+{
+    if (longest <= range[0]) {
+        return 0;
+    }
+    else if (longest >= range[dof]) {
+        return dof;
+    }
+
+    return longest - range[0];
+}
+
+static double ChiSquare(const size_t* frequencies, size_t countBlocks, size_t dof, const double* pi)
+{
+    auto sum = 0.0;
+    for (size_t i = 0; i <= dof; ++i) {
+        auto term = frequencies[i] - countBlocks * pi[i];
+        sum += term * term / (countBlocks * pi[i]);
+    }
+
+    return sum;
+}
+
+template <typename Word>
+static double CalculatePValue(const BitSpan<Word>& bits)
+{
+    auto params = SelectParameters(bits.Length());
+    auto countBlocks = bits.Length() / params.blockLength;
+
+    size_t frequencies[MaxDof + 1] = { 0, };
+    for (size_t i = 0, pos = 0; i < countBlocks; ++i) {
+        size_t longest = 0;
+        size_t run = 0;
+
+        for (size_t j = 0; j < params.blockLength; ++j, ++pos) {
+            run = (bits.BitAt(pos) == 1) ? run + 1 : 0;
+            if (longest < run) {
+                longest = run;
+            }
+        }
+
+        frequencies[FrequencyIndex(longest, params.dof, params.range)] += 1;
+    }
+
+    auto chisquare = ChiSquare(frequencies, countBlocks, params.dof, params.pi);
+    return igammac(params.dof/2.0, chisquare/2.0);
+}
+
 const std::string LongestRunTest::Name() const
 {
     return "Longest run of ones in a block test";
@@ -31,8 +103,63 @@ size_t LongestRunTest::MinimumLengthInBits() const
 std::vector<randomness_result_t> LongestRunTest::Evaluate(const Sample& sample)
 {
     Initialize(sample.BinaryData().size());
-    
-    auto chisquare = CalculateStatistic(sample);
+    BuildFrequencyTable(sample.BinaryData().data());
+
+    return Conclude();
+}
+
+void LongestRunTest::Begin(size_t lengthInBits)
+{
+    Initialize(lengthInBits);
+
+    run = 0;
+    longest = 0;
+    blockFill = 0;
+    countProcessedBlocks = 0;
+}
+
+void LongestRunTest::Accumulate(const Sample& chunk)
+{
+    for (auto bit : chunk.BinaryData()) {
+        if (countProcessedBlocks >= countBlocks) {
+            break;
+        }
+
+        run = (bit == 1) ? run + 1 : 0;
+        if (longest < run) {
+            longest = run;
+        }
+
+        if (++blockFill == blockLength) {
+            UpdateFrequencies(longest);
+            countProcessedBlocks += 1;
+
+            run = 0;
+            longest = 0;
+            blockFill = 0;
+        }
+    }
+}
+
+std::vector<randomness_result_t> LongestRunTest::Finalize()
+{
+    countBlocks = countProcessedBlocks;
+    return Conclude();
+}
+
+double LongestRunTest::PValue(const BitSpan<uint8_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+double LongestRunTest::PValue(const BitSpan<uint64_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+std::vector<randomness_result_t> LongestRunTest::Conclude()
+{
+    auto chisquare = CalculateStatistic();
     auto pvalue = igammac(dof/2.0, chisquare/2.0);
 
     auto result = std::vector<randomness_result_t>{};
@@ -45,18 +172,8 @@ std::vector<randomness_result_t> LongestRunTest::Evaluate(const Sample& sample)
 
 void LongestRunTest::Initialize(size_t length)
 {
-    if (length < 128) {
-        throw std::invalid_argument("sample length is too short");
-    }
-    else if (length < 6272) {
-        Initialize(8, 3, PI3, RANGE3);
-    }
-    else if (length < 750000) {
-        Initialize(128, 5, PI5, RANGE5);
-    }
-    else {
-        Initialize(10000, 6, PI6, RANGE6);
-    }
+    auto params = SelectParameters(length);
+    Initialize(params.blockLength, params.dof, params.pi, params.range);
 
     countBlocks = length / blockLength;
     frequencies.assign(dof + 1, 0);
@@ -70,17 +187,9 @@ void LongestRunTest::Initialize(size_t blockLength, size_t dof, const double* pi
     this->range = range;
 }
 
-double LongestRunTest::CalculateStatistic(const Sample& sample)
+double LongestRunTest::CalculateStatistic()
 {
-    BuildFrequencyTable(sample.BinaryData().data());
-
-    auto sum = 0.0;
-    for (size_t i = 0; i <= dof; ++i) {
-        auto term = frequencies[i] - countBlocks * pi[i];
-        sum += term * term / (countBlocks * pi[i]);
-    }
-
-    return sum;
+    return ChiSquare(frequencies.data(), countBlocks, dof, pi);
 }
 
 void LongestRunTest::BuildFrequencyTable(const uint8_t* block)
@@ -109,19 +218,14 @@ size_t LongestRunTest::FindLongestRun(const uint8_t* block)
         }
     }
 
+    if (longest < run) {
+        longest = run;
+    }
+
     return longest;
 }
 
 void LongestRunTest::UpdateFrequencies(size_t longest)
 {
-    if (longest <= range[0]) {
-        frequencies[0] += 1;
-        return;
-    }
-    else if (longest >= range[dof]) {
-        frequencies[dof] += 1;
-        return;
-    }
-
-    frequencies[longest - range[0]] += 1;
+    frequencies[FrequencyIndex(longest, dof, range)] += 1;
 }
\ No newline at end of file
@@ -38,6 +38,11 @@ namespace randomness { namespace sp800_22 {
         const double* pi;
         const size_t* range;
         std::vector<size_t> frequencies;
+
+        size_t run;
+        size_t longest;
+        size_t blockFill;
+        size_t countProcessedBlocks;
         
     public:
         const std::string Name() const override;
@@ -45,10 +50,18 @@ namespace randomness { namespace sp800_22 {
         size_t MinimumLengthInBits() const override;
         std::vector<randomness_result_t> Evaluate(const Sample& sample) override;
 
+        void Begin(size_t lengthInBits) override;
+        void Accumulate(const Sample& chunk) override;
+        std::vector<randomness_result_t> Finalize() override;
+
+        double PValue(const BitSpan<uint8_t>& bits) const override;
+        double PValue(const BitSpan<uint64_t>& bits) const override;
+
     private:
         void Initialize(size_t length);
         void Initialize(size_t blockLength, size_t dof, const double* pi, const size_t* range);
-        double CalculateStatistic(const Sample& sample);
+        std::vector<randomness_result_t> Conclude();
+        double CalculateStatistic();
         
         inline void BuildFrequencyTable(const uint8_t* block);
         inline size_t FindLongestRun(const uint8_t* block);
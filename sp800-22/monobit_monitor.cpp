@@ -0,0 +1,69 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "monobit_monitor.h"
+
+#include "../common/hamming_weight.h"
+
+using namespace randomness::sp800_22;
+using namespace randomness::common;
+
+MonobitMonitor::MonobitMonitor(size_t windowLengthInBits) : window(windowLengthInBits >> 3)
+{
+    if ((windowLengthInBits & 0x7) != 0 || windowLengthInBits < MinimumLengthInBits()) {
+        throw std::invalid_argument("invalid window length");
+    }
+}
+
+void MonobitMonitor::Push(uint8_t word)
+{
+    uint8_t evicted = 0;
+    if (window.Push(word, evicted)) {
+        windowOnes -= HammingWeight(evicted);
+    }
+
+    windowOnes += HammingWeight(word);
+}
+
+void MonobitMonitor::Push(const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        Push(data[i]);
+    }
+}
+
+size_t MonobitMonitor::LengthInBits() const
+{
+    return window.Size() << 3;
+}
+
+std::vector<randomness_result_t> MonobitMonitor::EvaluateWindow()
+{
+    logstream.str("");
+    if (window.Empty()) {
+        return {};
+    }
+
+    return Conclude(windowOnes, LengthInBits());
+}
\ No newline at end of file
@@ -46,12 +46,57 @@ size_t MonobitTest::MinimumLengthInBits() const
     return 100;
 }
 
+static double CalculatePValue(size_t hw, size_t length, double& sobs)
+{
+    sobs = (2.0 * hw - static_cast<double>(length)) / sqrt(length);
+    return std::erfc(fabs(sobs) / SQRT2);
+}
+
+template <typename Word>
+static double CalculatePValue(const BitSpan<Word>& bits)
+{
+    auto sobs = 0.0;
+    return CalculatePValue(bits.HammingWeight(0, bits.Length()), bits.Length(), sobs);
+}
+
 std::vector<randomness_result_t> MonobitTest::Evaluate(const Sample& sample)
 {
-    auto length = sample.BinaryData().size();
-    auto hw = HammingWeight(sample);
-    auto sobs = (2 * hw - length) / sqrt(length);
-    auto pvalue = std::erfc(sobs / SQRT2);
+    return Conclude(HammingWeight(sample), sample.BinaryData().size());
+}
+
+void MonobitTest::Begin(size_t)
+{
+    countBits = 0;
+    countOnes = 0;
+}
+
+void MonobitTest::Accumulate(const Sample& chunk)
+{
+    auto& bits = chunk.BinaryData();
+
+    countBits += bits.size();
+    countOnes += HammingWeight(bits);
+}
+
+std::vector<randomness_result_t> MonobitTest::Finalize()
+{
+    return Conclude(countOnes, countBits);
+}
+
+double MonobitTest::PValue(const BitSpan<uint8_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+double MonobitTest::PValue(const BitSpan<uint64_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+std::vector<randomness_result_t> MonobitTest::Conclude(size_t hw, size_t length)
+{
+    auto sobs = 0.0;
+    auto pvalue = CalculatePValue(hw, length, sobs);
 
     logstream << "count 1s = " << hw << ", Sobs = " << sobs;
 
@@ -46,7 +46,7 @@ size_t RunsTest::MinimumLengthInBits() const
 
 static size_t TotalNumberOfOnes(const Sample& sample)
 {
-    auto data = sample.OctalData();
+    auto& data = sample.OctalData();
     auto length = data.size();
 
     size_t vobs = 1;
@@ -61,27 +61,113 @@ static size_t TotalNumberOfOnes(const Sample& sample)
     return vobs;
 }
 
-static double CalculateStatistic(const Sample& sample, double pi)
+static double CalculateStatistic(size_t vobs, size_t length, double pi)
 {
-    auto vobs = TotalNumberOfOnes(sample);
     auto term = pi * (1.0 - pi);
 
-    auto length = sample.BinaryData().size();
     auto numerator = abs(vobs - (2 * length * term));
     auto denominator = 2 * sqrt(2 * length) * term;
 
     return numerator / denominator;
 }
 
+static inline bool PassesPrerequisite(double pi, double tau)
+{
+    return abs(pi - 0.5) < tau;
+}
+
+template <typename Word>
+static size_t TotalNumberOfRuns(const BitSpan<Word>& bits)
+{
+    constexpr auto WordBits = BitSpan<Word>::WordBits;
+
+    size_t vobs = 1;
+    for (size_t i = 0; i < bits.CountWords(); ++i) {
+        auto word = bits.WordAt(i);
+        auto valid = bits.ValidBits(i);
+
+        // bit k of (word ^ word >> 1) tells whether the bits k and k + 1 differ
+        auto inner = static_cast<Word>(((static_cast<Word>(1) << (valid - 1)) - 1) << (WordBits - valid));
+        vobs += __builtin_popcountll(static_cast<Word>(word ^ (word >> 1)) & inner);
+
+        if (i > 0) {
+            vobs += bits.BitAt(i * WordBits - 1) ^ (word >> (WordBits - 1));
+        }
+    }
+
+    return vobs;
+}
+
+template <typename Word>
+static double CalculatePValue(const BitSpan<Word>& bits)
+{
+    auto length = bits.Length();
+    auto pi = bits.HammingWeight(0, length) / static_cast<double>(length);
+    auto tau = 2.0 / length;
+
+    if (PassesPrerequisite(pi, tau) == false) {
+        return 0.0;
+    }
+
+    return std::erfc(CalculateStatistic(TotalNumberOfRuns(bits), length, pi));
+}
+
 std::vector<randomness_result_t> RunsTest::Evaluate(const Sample& sample)
 {
     auto length = sample.BinaryData().size();
-    auto pi = HammingWeight(sample) / static_cast<double>(length);
+    return Conclude(HammingWeight(sample), TotalNumberOfOnes(sample), length);
+}
+
+void RunsTest::Begin(size_t)
+{
+    countBits = 0;
+    countOnes = 0;
+    countRuns = 1;
+    lastBit = 0;
+}
+
+void RunsTest::Accumulate(const Sample& chunk)
+{
+    auto& bits = chunk.BinaryData();
+    if (bits.empty()) {
+        return;
+    }
+
+    // a run crossing the chunk boundary is continued from the last bit of the previous chunk
+    auto prev = (countBits > 0) ? lastBit : bits[0];
+    for (auto bit : bits) {
+        countRuns += bit ^ prev;
+        countOnes += bit;
+        prev = bit;
+    }
+
+    countBits += bits.size();
+    lastBit = prev;
+}
+
+std::vector<randomness_result_t> RunsTest::Finalize()
+{
+    return Conclude(countOnes, countRuns, countBits);
+}
+
+double RunsTest::PValue(const BitSpan<uint8_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+double RunsTest::PValue(const BitSpan<uint64_t>& bits) const
+{
+    return CalculatePValue(bits);
+}
+
+std::vector<randomness_result_t> RunsTest::Conclude(size_t hw, size_t vobs, size_t length)
+{
+    auto pi = hw / static_cast<double>(length);
     auto tau = 2.0 / length;
 
     auto pvalue = 0.0;
-    if (abs(pi - 0.5) < tau) {
-        auto fraction = CalculateStatistic(sample, pi);
+    if (PassesPrerequisite(pi, tau)) {
+        auto fraction = CalculateStatistic(vobs, length, pi);
         pvalue = std::erfc(fraction);
 
         logstream << "𝜋 = " << pi << ", 𝜏 = " << tau << ", fraction = " << fraction;
@@ -31,11 +31,27 @@ namespace randomness { namespace sp800_22 {
     
     class RunsTest : public StatisticalTest 
     {
+    private:
+        size_t countBits;
+        size_t countOnes;
+        size_t countRuns;
+        uint8_t lastBit;
+
     public:
         const std::string Name() const override;
         const std::string ShortName() const override;
         size_t MinimumLengthInBits() const override;
         std::vector<randomness_result_t> Evaluate(const Sample& sample) override;
+
+        void Begin(size_t lengthInBits) override;
+        void Accumulate(const Sample& chunk) override;
+        std::vector<randomness_result_t> Finalize() override;
+
+        double PValue(const BitSpan<uint8_t>& bits) const override;
+        double PValue(const BitSpan<uint64_t>& bits) const override;
+
+    protected:
+        std::vector<randomness_result_t> Conclude(size_t hw, size_t vobs, size_t length);
     };
 }}
 
@@ -0,0 +1,95 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_22_SLIDING_WINDOW_H__
+#define __RANDOMNESS_SP800_22_SLIDING_WINDOW_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace randomness { namespace sp800_22 {
+
+    /**
+     * Fixed-capacity ring buffer holding the most recent items of a stream.
+     */
+    template <typename T>
+    class SlidingWindow 
+    {
+    private:
+        std::vector<T> ring;
+        size_t head = 0;
+        size_t count = 0;
+
+    public:
+        SlidingWindow(size_t capacity) : ring(capacity) {}
+
+        // returns true when the oldest item had to leave the window, which is stored in evicted
+        bool Push(T value, T& evicted)
+        {
+            auto tail = head + count;
+            if (tail >= ring.size()) {
+                tail -= ring.size();
+            }
+
+            if (count < ring.size()) {
+                ring[tail] = value;
+                count += 1;
+                return false;
+            }
+
+            evicted = ring[head];
+            ring[head] = value;
+            head = (head + 1 == ring.size()) ? 0 : head + 1;
+            return true;
+        }
+
+        T Oldest() const
+        {
+            return ring[head];
+        }
+
+        T Newest() const
+        {
+            auto tail = head + count - 1;
+            return ring[tail < ring.size() ? tail : tail - ring.size()];
+        }
+
+        size_t Size() const
+        {
+            return count;
+        }
+
+        size_t Capacity() const
+        {
+            return ring.size();
+        }
+
+        bool Empty() const
+        {
+            return count == 0;
+        }
+    };
+}}
+
+#endif
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include <sstream>
 #include <vector>
 
+#include "../common/bit_span.h"
 #include "../common/sample.h"
 
 namespace randomness { namespace sp800_22 {
@@ -58,6 +59,22 @@ namespace randomness { namespace sp800_22 {
         virtual const std::string ShortName() const = 0;
         virtual size_t MinimumLengthInBits() const = 0;
         virtual std::vector<randomness_result_t> Evaluate(const Sample& sample) = 0;
+
+        /**
+         * Streaming evaluation: Begin() with the expected length of the whole sequence,
+         * Accumulate() its chunks in order, then Finalize() to get the same results
+         * Evaluate() would give on the concatenated sequence.
+         */
+        virtual void Begin(size_t lengthInBits) = 0;
+        virtual void Accumulate(const Sample& chunk) = 0;
+        virtual std::vector<randomness_result_t> Finalize() = 0;
+
+        /**
+         * Evaluation on caller memory without copying it into a Sample. It neither allocates
+         * nor modifies the test, so a single instance may be shared among threads.
+         */
+        virtual double PValue(const BitSpan<uint8_t>& bits) const = 0;
+        virtual double PValue(const BitSpan<uint64_t>& bits) const = 0;
     };
 }}
 
@@ -0,0 +1,74 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_BINARY_CONTEXT_TABLE_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_BINARY_CONTEXT_TABLE_H__
+
+#include <cstdint>
+#include <vector>
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    /**
+     * Counts the bits following every binary context of 1 to MaxOrder bits, for the binary 
+     * MultiMMC and LZ78Y predictors. The latest bits are kept in one word, newest lowest, and the 
+     * context of order d is its lowest d bits. The count pairs of all orders share one array, 
+     * those of order d placed after the 2^(d + 1) - 4 counts of the lower orders.
+     */
+    class BinaryContextTable {
+    public:
+        static constexpr size_t MaxOrder = 16;
+
+    private:
+        uint32_t window = 0;
+        std::vector<uint32_t> counts;
+
+    public:
+        BinaryContextTable() : counts((static_cast<size_t>(4) << MaxOrder) - 4, 0) {}
+
+        // the window is set to the bits of sample[0..length)
+        void Load(const uint8_t* sample, size_t length)
+        {
+            window = 0;
+            for (size_t i = 0; i < length; ++i) {
+                Push(sample[i]);
+            }
+        }
+
+        void Push(uint8_t bit)
+        {
+            window = (window << 1) | bit;
+        }
+
+        // the counts of 0 and 1 following the current context of the given order
+        uint32_t* Follows(size_t order)
+        {
+            auto context = window & ((static_cast<uint32_t>(1) << order) - 1);
+            return counts.data() + (static_cast<size_t>(2) << order) - 4 + 2 * context;
+        }
+    };
+}}}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "binary_tuple_counter.h"
+#include "../../common/bit_span.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace randomness::common;
+using namespace randomness::sp800_90b::estimator;
+
+// the table for the directly counted tuples takes 4 << DirectTupleBits bytes
+static constexpr size_t DirectTupleBits = 24;
+
+static constexpr size_t RadixBits = 8;
+static constexpr size_t RadixBuckets = 1 << RadixBits;
+
+static void RadixSort(std::vector<uint64_t>& keys)
+{
+    auto tmp = std::vector<uint64_t>(keys.size());
+    auto offsets = std::vector<size_t>(RadixBuckets + 1);
+
+    for (size_t shift = 0; shift < 64; shift += RadixBits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (auto key : keys) {
+            offsets[((key >> shift) & (RadixBuckets - 1)) + 1] += 1;
+        }
+
+        for (size_t d = 1; d <= RadixBuckets; ++d) {
+            offsets[d] += offsets[d - 1];
+        }
+
+        for (auto key : keys) {
+            tmp[offsets[(key >> shift) & (RadixBuckets - 1)]++] = key;
+        }
+
+        keys.swap(tmp);
+    }
+}
+
+static inline uint64_t PrefixMask(size_t t)
+{
+    return ~static_cast<uint64_t>(0) << (64 - t);
+}
+
+// number of sorted windows sharing the first t bits of key
+static size_t CountPrefix(const std::vector<uint64_t>& keys, uint64_t key, size_t t)
+{
+    auto lower = key & PrefixMask(t);
+    auto upper = lower | ~PrefixMask(t);
+
+    return std::upper_bound(keys.begin(), keys.end(), upper) - std::lower_bound(keys.begin(), keys.end(), lower);
+}
+
+static size_t BitLength(size_t value)
+{
+    size_t bits = 0;
+    while ((bits < 64) && (value >> bits) > 0) {
+        bits += 1;
+    }
+    return bits;
+}
+
+/**
+ * Counts every t-tuple up to about log2(length) bits in a table, which is where random data 
+ * reaches the cut-off. The counts of t-tuples are folded from those of (t + 1)-tuples, plus the 
+ * one t-tuple at the very end. Q is filled from t = 1 on, and true is returned if the cut-off 
+ * is reached.
+ */
+static bool CountDirectly(const uint8_t* data, size_t length, size_t minimumCount, std::vector<size_t>& Q)
+{
+    auto maxBits = std::min(BitLength(length), DirectTupleBits);
+    auto counts = std::vector<uint32_t>(static_cast<size_t>(1) << maxBits, 0);
+    auto maxima = std::vector<size_t>(maxBits + 1, 0);
+
+    uint64_t window = 0;
+    auto mask = (static_cast<uint64_t>(1) << maxBits) - 1;
+    for (size_t i = 0; i < length; ++i) {
+        window = ((window << 1) | data[i]) & mask;
+        if (i + 1 >= maxBits) {
+            counts[window] += 1;
+        }
+    }
+    maxima[maxBits] = *std::max_element(counts.begin(), counts.end());
+
+    for (auto t = maxBits - 1; t > 0; --t) {
+        auto countTuples = static_cast<size_t>(1) << t;
+        for (size_t w = 0; w < countTuples; ++w) {
+            counts[w] = counts[2 * w] + counts[2 * w + 1];
+        }
+
+        uint64_t last = 0;
+        for (auto i = length - t; i < length; ++i) {
+            last = (last << 1) | data[i];
+        }
+        counts[last] += 1;
+
+        maxima[t] = *std::max_element(counts.begin(), counts.begin() + countTuples);
+    }
+
+    for (size_t t = 1; t <= maxBits; ++t) {
+        Q.push_back(maxima[t]);
+        if (maxima[t] < minimumCount) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Goes on from the t in Q with the 64-bit windows sorted: equal t-tuples are then adjacent, 
+ * and the most common one is the longest run of windows sharing their first t bits.
+ */
+static bool CountSorted(const uint8_t* data, size_t length, size_t minimumCount, std::vector<size_t>& Q)
+{
+    auto packed = std::vector<uint64_t>((length + 63) / 64, 0);
+    for (size_t i = 0; i < length; ++i) {
+        packed[i / 64] |= static_cast<uint64_t>(data[i]) << (63 - i % 64);
+    }
+    auto bits = BitSpan<uint64_t>(packed.data(), length);
+
+    // the windows lying wholly inside the sample are sorted, and the last 63 are handled aside
+    auto countFull = length - BinaryTupleCounter::MaxTupleLength + 1;
+    auto keys = std::vector<uint64_t>(countFull);
+    for (size_t i = 0; i < countFull; ++i) {
+        keys[i] = bits.BitsFrom(i);
+    }
+    RadixSort(keys);
+
+    auto common = std::vector<uint8_t>(countFull, 0);
+    for (size_t k = 1; k < countFull; ++k) {
+        auto diff = keys[k] ^ keys[k - 1];
+        common[k] = (diff == 0) ? 64 : __builtin_clzll(diff);
+    }
+
+    for (auto t = Q.size(); t <= BinaryTupleCounter::MaxTupleLength; ++t) {
+        size_t count = 1;
+        size_t run = 1;
+        for (size_t k = 1; k < countFull; ++k) {
+            run = (common[k] >= t) ? run + 1 : 1;
+            count = std::max(count, run);
+        }
+
+        // a short window only counts for the tuples it still covers
+        for (auto i = countFull; i + t <= length; ++i) {
+            auto prefix = bits.BitsFrom(i) & PrefixMask(t);
+
+            size_t tail = 0;
+            for (auto j = countFull; j + t <= length; ++j) {
+                tail += ((bits.BitsFrom(j) & PrefixMask(t)) == prefix);
+            }
+
+            count = std::max(count, CountPrefix(keys, prefix, t) + tail);
+        }
+
+        Q.push_back(count);
+        if (count < minimumCount) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool BinaryTupleCounter::Count(const uint8_t* data, size_t length, size_t minimumCount, std::vector<size_t>& Q)
+{
+    Q.assign(1, 1);
+
+    if ((length < 2 * MaxTupleLength) || (length >= UINT32_MAX)) {
+        return false;
+    }
+
+    size_t ones = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] > 1) {
+            return false;
+        }
+        ones += data[i];
+    }
+
+    if (CountDirectly(data, length, minimumCount, Q)) {
+        return true;
+    }
+
+    // a bias this strong repeats the 64-bit run of the common symbol past the cut-off anyway
+    auto p = std::max(ones, length - ones) / static_cast<double>(length);
+    if (length * std::pow(p, MaxTupleLength) >= minimumCount) {
+        return false;
+    }
+
+    return CountSorted(data, length, minimumCount, Q);
+}
@@ -0,0 +1,53 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_BINARY_TUPLE_COUNTER_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_BINARY_TUPLE_COUNTER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    /**
+     * Counts the overlapping t-bit tuples of a binary sample without a suffix array, for the 
+     * t-Tuple estimate of samples whose tuples stop repeating 35 times within 64 bits.
+     * Short tuples are counted in a table, longer ones from the sorted 64-bit windows.
+     */
+    class BinaryTupleCounter {
+    public:
+        static constexpr size_t MaxTupleLength = 64;
+
+    public:
+        /**
+         * Fills Q[t] with the number of occurrences of the most common t-tuple for t = 1, 2, ...
+         * up to the first t where it falls below minimumCount. Returns false if that does not
+         * happen within MaxTupleLength bits.
+         */
+        static bool Count(const uint8_t* data, size_t length, size_t minimumCount, std::vector<size_t>& Q);
+    };
+}}}
+
+#endif
\ No newline at end of file
@@ -24,28 +24,92 @@
 
 #include "lag_prediction_estimator.h"
 
-#include <vector>
-
 using namespace randomness::sp800_90b::estimator;
 
-static constexpr size_t MaxLagSize = 128;
+LagPredictionEstimator::LagPredictionEstimator(size_t countThreads) : PredictionEngine(countThreads) 
+{
+}
 
 std::string LagPredictionEstimator::Name() const
 {
     return "Lag Prediction Estimate";
 }
 
-void LagPredictionEstimator::Initialize()
+/**
+ * The lag d subpredictor guesses sample[idx - 1 - d], so its hits need no state besides the sample 
+ * itself. A binary history is shifted through the bits of the hits instead, and on a hit for 
+ * most lags the scoreboard is kept in planes.
+ */
+void LagPredictionEstimator::MakePredictions()
 {
     startPredictionIndex = 1;
     countPredictions = countSamples - startPredictionIndex;
-    
-    prediction.assign(MaxLagSize, -1);
-    scoreboard.assign(MaxLagSize, 0);
+    slicedScoreboard = (countAlphabets == 2);
+
+    if (countAlphabets != 2) {
+        RunParallel([this](size_t) {
+            return [this](size_t idx) {
+                return MatchHistory(idx);
+            };
+        });
+        return;
+    }
+
+    RunParallel([this](size_t begin) {
+        // bit d of history is sample[idx - 1 - d], and valid marks the lags within the sample
+        hits_t history, valid;
+        history.fill(0);
+        valid.fill(0);
+        for (size_t d = 0; (d < CountPredictors) && (d < begin); ++d) {
+            history[d / 64] |= static_cast<uint64_t>(sample[begin - 1 - d]) << (d % 64);
+            valid[d / 64] |= static_cast<uint64_t>(1) << (d % 64);
+        }
+
+        return [this, begin, history, valid](size_t idx) mutable {
+            if (idx > begin) {
+                for (auto w = CountWords; w-- > 1;) {
+                    history[w] = (history[w] << 1) | (history[w - 1] >> 63);
+                    valid[w] = (valid[w] << 1) | (valid[w - 1] >> 63);
+                }
+                history[0] = (history[0] << 1) | sample[idx - 1];
+                valid[0] = (valid[0] << 1) | 1;
+            }
+
+            hits_t hits;
+            for (size_t w = 0; w < CountWords; ++w) {
+                hits[w] = (sample[idx] ? history[w] : ~history[w]) & valid[w];
+            }
+            return hits;
+        };
+    });
 }
 
-void LagPredictionEstimator::UpdatePredictions(size_t idx)
+/**
+ * Hits of every lag on sample[idx], compared 8 lags at a time within a word. The zero bytes 
+ * of the difference become single bits, gathered in reverse by one multiplication, as the 
+ * lags run backwards through memory.
+ */
+LagPredictionEstimator::hits_t LagPredictionEstimator::MatchHistory(size_t idx) const
 {
-    prediction.insert(prediction.begin(), sample[idx - 1]);
-    prediction.erase(prediction.end() - 1);
+    hits_t hits;
+    hits.fill(0);
+
+    if (idx < CountPredictors) {
+        for (size_t d = 0; d < idx; ++d) {
+            hits[d / 64] |= static_cast<uint64_t>(sample[idx - 1 - d] == sample[idx]) << (d % 64);
+        }
+        return hits;
+    }
+
+    auto pattern = static_cast<uint64_t>(0x0101010101010101) * sample[idx];
+    for (size_t w = 0; w < CountWords; ++w) {
+        for (size_t g = 0; g < 64; g += 8) {
+            auto bytes = LoadLittleEndian(sample + idx - 8 - w * 64 - g);
+            auto diff = bytes ^ pattern;
+            auto zeros = ~(((diff & 0x7f7f7f7f7f7f7f7f) + 0x7f7f7f7f7f7f7f7f) | diff | 0x7f7f7f7f7f7f7f7f);
+            hits[w] |= (((zeros >> 7) * 0x8040201008040201) >> 56) << g;
+        }
+    }
+
+    return hits;
 }
\ No newline at end of file
@@ -25,20 +25,21 @@
 #ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_LAG_H__
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_LAG_H__
 
-#include "prediction_estimator.h"
-
-#include <vector>
+#include "prediction_engine.h"
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
-    class LagPredictionEstimator : public PredictionEstimator 
+    class LagPredictionEstimator : public PredictionEngine<128> 
     {
     public:
+        explicit LagPredictionEstimator(size_t countThreads = 1);
+
         std::string Name() const override;
     
     private:
-        void Initialize() override;
-        void UpdatePredictions(size_t idx) override;
+        void MakePredictions() override;
+
+        hits_t MatchHistory(size_t idx) const;
     };
 }}}
 
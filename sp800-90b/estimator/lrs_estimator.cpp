@@ -48,17 +48,15 @@ static inline size_t FindSmallestU(const std::vector<size_t>& Q, size_t max_lcp)
     return u;
 }
 
-double LrsEstimator::Estimate(const LcpArray& lcp)
+double LrsEstimator::Estimate(const TupleStatistics& statistics)
 {
-    auto len = lcp.Array().size();
-    auto Q = GetMaximumTupleCounts(lcp, len);
-    auto u = FindSmallestU(Q, lcp.Max());
-    auto v = lcp.Max();
+    auto len = statistics.Length();
+    auto u = FindSmallestU(statistics.MaximumTupleCounts(), statistics.MaxLcp());
+    auto v = statistics.MaxLcp();
 
-    auto C = GetLRS(lcp, u, len);
-    auto pmax = CalculateMaximumProbability(C, u, v, len);
+    auto pmax = CalculateMaximumProbability(statistics.TuplePairCounts(), u, v, len);
 
-    logstream << "u=" << u << ", v=" << lcp.Max() << ", pmax=" << pmax;
+    logstream << "u=" << u << ", v=" << v << ", pmax=" << pmax;
 
     return -log2(UpperBoundProbability(pmax, len));
 }
@@ -77,44 +75,3 @@ double LrsEstimator::CalculateMaximumProbability(const std::vector<size_t>& C, s
 
     return pmax;
 }
-
-/**
- * Based on the code below:
- * https://github.com/usnistgov/SP800-90B_EntropyAssessment/blob/master/cpp/shared/lrs_test.h
- */
-std::vector<size_t> LrsEstimator::GetLRS(const LcpArray& lcp, size_t u, size_t length)
-{    
-    auto max_lcp = lcp.Max();
-
-    auto A = std::vector<size_t>(max_lcp + 2, 0);
-    auto S = std::vector<size_t>(max_lcp + 1, 0);
-
-    for (size_t i = 1; i <= length; ++i) {
-        if ((lcp[i - 1] >= u) && (lcp[i] < lcp[i - 1])) {
-            auto b = lcp[i];
-
-            if (b < u) {
-                b = u - 1;
-            }
-
-            for (auto t = lcp[i - 1]; t > b; --t) {
-                A[t] += A[t + 1];
-                A[t + 1] = 0;
-
-                S[t] += ((A[t] + 1) * A[t]) >> 1;
-            }
-
-            if (b >= u) {
-                A[b] += A[b + 1];
-            }
-
-            A[b + 1] = 0;
-        }
-
-        if (lcp[i] >= u) {
-            A[lcp[i]]++;
-        }
-    }
-
-    return S;
-}
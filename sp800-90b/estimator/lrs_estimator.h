@@ -26,7 +26,6 @@
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_LRS_H__
 
 #include "tuple_estimator.h"
-#include "../../algorithm/lcp_array.h"
 
 #include <vector>
 
@@ -37,12 +36,13 @@ namespace randomness { namespace sp800_90b { namespace estimator {
     class LrsEstimator : public TupleEstimator 
     {
     public:
+        using TupleEstimator::Estimate;
+
         std::string Name() const override;
         double Estimate() override;
-        double Estimate(const LcpArray& lcp) override;
+        double Estimate(const TupleStatistics& statistics) override;
 
     private:
-        std::vector<size_t> GetLRS(const LcpArray& lcp, size_t u, size_t length);
         double CalculateMaximumProbability(const std::vector<size_t>& S, size_t u, size_t v, size_t length) const;
     };
 }}}
@@ -23,7 +23,6 @@
  */
 
 #include "lz78y_prediction_estimator.h"
-#include "prediction_estimator.h"
 
 using namespace randomness::sp800_90b::estimator;
 
@@ -35,55 +34,76 @@ std::string Lz78yPredictionEstimator::Name() const
     return "LZ78Y Prediction Estimate";
 }
 
-void Lz78yPredictionEstimator::Initialize()
+void Lz78yPredictionEstimator::MakePredictions()
 {
     entries = 0;
     startPredictionIndex = WindowSize + 1;
     countPredictions = countSamples - WindowSize - 1;
 
-    prediction.assign(1, -1);
-    scoreboard.clear();
-
-    dictionary.clear();
-    for (auto i = 0; i < WindowSize; ++i) {
-        if (countAlphabets == 2) {
-            dictionary.push_back(std::make_shared<Lz78yPredictorBinary>());
-        } 
-        else {
-            dictionary.push_back(std::make_shared<Lz78yPredictorLiteral>());
-        }
-        
-        dictionary[i]->Initialize(sample, WindowSize - 1 - i);
+    if (countAlphabets == 2) {
+        MakeBinaryPredictions();
+    }
+    else if (countAlphabets <= 4) {
+        MakeLiteralPredictions<4>();
+    }
+    else if (countAlphabets <= 16) {
+        MakeLiteralPredictions<16>();
+    }
+    else {
+        MakeLiteralPredictions<256>();
     }
-    entries += WindowSize;
 }
 
-void Lz78yPredictionEstimator::UpdatePredictions(size_t idx)
+template <size_t Alphabet>
+void Lz78yPredictionEstimator::MakeLiteralPredictions()
 {
-    prediction[0] = -1;
-    auto max = 0;
+    Lz78yTrie<Alphabet> dictionary(WindowSize, MaxEntries);
+    dictionary.Initialize(sample, WindowSize);
 
-    for (auto i = 0; i < WindowSize; ++i) {
-        auto mcv = dictionary[i]->Predict(sample[idx]);
+    Run([&](size_t idx) {
+        prediction[0] = dictionary.Predict(sample, idx);
+    });
+}
 
-        if (mcv.key != -1) {
-            if ((max < mcv.count) || ((max == mcv.count) && (prediction[0] < mcv.key))) {
-                prediction[0] = mcv.key;
-                max = mcv.count;
-            }
-        }
-        else {
-            for (auto j = i; j < WindowSize; ++j) {
-                if (entries < MaxEntries) {
-                    dictionary[j]->CreateEntry(sample[idx]);
-                    entries += 1;
+/**
+ * The dictionaries of the 16 context lengths are counted in one table. A context is in its 
+ * dictionary exactly when its counts are not both zero, and then so is every shorter one.
+ */
+void Lz78yPredictionEstimator::MakeBinaryPredictions()
+{
+    BinaryContextTable table;
+    table.Load(sample, WindowSize);
+    for (size_t order = 1; order <= WindowSize; ++order) {
+        table.Follows(order)[sample[WindowSize]] = 1;
+    }
+    table.Push(sample[WindowSize]);
+    entries += WindowSize;
+
+    Run([&](size_t idx) {
+        auto feed = sample[idx];
+        auto seen = true;
+        size_t max = 0;
+
+        prediction[0] = -1;
+        for (size_t order = 1; order <= WindowSize; ++order) {
+            auto follows = table.Follows(order);
+            int16_t key = (follows[0] > follows[1]) ? 0 : 1;
+            size_t count = follows[key];
+            seen = seen && (count > 0);
+
+            if (seen) {
+                if ((max < count) || ((max == count) && (prediction[0] < key))) {
+                    prediction[0] = key;
+                    max = count;
                 }
+                follows[feed] += 1;
+            }
+            else if (entries < MaxEntries) {
+                follows[feed] = 1;
+                entries += 1;
             }
-            break;
         }
-    }
 
-    for (auto dict : dictionary) {
-        dict->UpdateTrace(sample[idx]);
-    }
-}
+        table.Push(feed);
+    });
+}
\ No newline at end of file
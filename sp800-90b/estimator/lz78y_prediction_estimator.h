@@ -25,28 +25,27 @@
 #ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_LZ78Y_H__
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_LZ78Y_H__
 
-#include "prediction_estimator.h"
+#include "prediction_engine.h"
 
-#include <map>
-#include <memory>
-#include <vector>
-
-#include "lz78y_predictor.h"
+#include "binary_context_table.h"
+#include "lz78y_trie.h"
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
-    class Lz78yPredictionEstimator : public PredictionEstimator 
+    class Lz78yPredictionEstimator : public PredictionEngine<1> 
     {
     private:
         size_t entries;
-        std::vector<std::shared_ptr<Lz78yPredictor>> dictionary;
         
     public:
         std::string Name() const override;
 
     private:
-        void Initialize();
-        void UpdatePredictions(size_t idx);
+        void MakePredictions() override;
+        void MakeBinaryPredictions();
+
+        template <size_t Alphabet>
+        void MakeLiteralPredictions();
     };
 }}}
 
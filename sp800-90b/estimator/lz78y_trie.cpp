@@ -0,0 +1,125 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lz78y_trie.h"
+
+using namespace randomness::sp800_90b::estimator;
+
+template <size_t Alphabet>
+Lz78yTrie<Alphabet>::Lz78yTrie(size_t depth, size_t maxEntries) : depth(depth), maxEntries(maxEntries), entries(0)
+{
+    // the root stands for the empty context, and is never a child
+    nodes.emplace_back();
+    if (Alphabet < 256) {
+        table.emplace_back();
+        table.back().fill(0);
+    }
+}
+
+template <size_t Alphabet>
+void Lz78yTrie<Alphabet>::Initialize(const uint8_t* sample, size_t position)
+{
+    Extend(0, sample, position, 0);
+}
+
+template <size_t Alphabet>
+int16_t Lz78yTrie<Alphabet>::Predict(const uint8_t* sample, size_t idx)
+{
+    int16_t prediction = -1;
+    size_t max = 0;
+
+    auto feed = sample[idx];
+    uint32_t node = 0;
+
+    for (size_t length = 0; length < depth; ++length) {
+        auto child = FindChild(node, sample[idx - 1 - length]);
+        if (child == 0) {
+            Extend(node, sample, idx, length);
+            break;
+        }
+
+        node = child;
+        auto mcv = nodes[node].MostCommonValue();
+        if ((max < mcv.count) || ((max == mcv.count) && (prediction < mcv.key))) {
+            prediction = mcv.key;
+            max = mcv.count;
+        }
+
+        nodes[node].Update(feed);
+    }
+
+    return prediction;
+}
+
+template <size_t Alphabet>
+uint64_t Lz78yTrie<Alphabet>::KeyOf(uint32_t node, uint8_t symbol)
+{
+    return (static_cast<uint64_t>(node) << SymbolBits) | symbol;
+}
+
+// enters the contexts longer than length below node, until the dictionary is full
+template <size_t Alphabet>
+void Lz78yTrie<Alphabet>::Extend(uint32_t node, const uint8_t* sample, size_t idx, size_t length)
+{
+    auto feed = sample[idx];
+
+    for (; (length < depth) && (entries < maxEntries); ++length) {
+        node = CreateChild(node, sample[idx - 1 - length]);
+        nodes[node].Create(feed);
+        entries += 1;
+    }
+}
+
+template <size_t Alphabet>
+uint32_t Lz78yTrie<Alphabet>::FindChild(uint32_t node, uint8_t symbol)
+{
+    if (Alphabet < 256) {
+        return table[node][symbol];
+    }
+
+    auto child = children.Find(KeyOf(node, symbol));
+    return (child == nullptr) ? 0 : *child;
+}
+
+template <size_t Alphabet>
+uint32_t Lz78yTrie<Alphabet>::CreateChild(uint32_t node, uint8_t symbol)
+{
+    auto child = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    if (Alphabet < 256) {
+        table.emplace_back();
+        table.back().fill(0);
+        table[node][symbol] = child;
+    }
+    else {
+        children[KeyOf(node, symbol)] = child;
+    }
+
+    return child;
+}
+
+template class randomness::sp800_90b::estimator::Lz78yTrie<4>;
+template class randomness::sp800_90b::estimator::Lz78yTrie<16>;
+template class randomness::sp800_90b::estimator::Lz78yTrie<256>;
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_LZ78Y_TRIE_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_LZ78Y_TRIE_H__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "mcv_tracker.h"
+#include "../../algorithm/hash_table.h"
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    /**
+     * The LZ78Y dictionaries of every context length up to depth in one trie, read from the newest 
+     * symbol back. The contexts of lengths 1, 2, ... ending at a position lie on a single path 
+     * from the root, so that one walk visits them in the order the predictor checks them.
+     * The samples are below Alphabet, one of 4, 16 and 256.
+     */
+    template <size_t Alphabet>
+    class Lz78yTrie {
+    static_assert((Alphabet == 4) || (Alphabet == 16) || (Alphabet == 256), "unsupported alphabet size");
+
+    static constexpr size_t SymbolBits = __builtin_ctz(Alphabet);
+
+    private:
+        size_t depth;
+        size_t maxEntries;
+        size_t entries;
+
+        /**
+         * The followers of each context, and the child reached from a node by a symbol. Below 256 
+         * symbols the children of a node are kept in a row of the table, 0 where there is none.
+         */
+        std::vector<McvTracker<Alphabet>> nodes;
+        std::vector<std::array<uint32_t, Alphabet>> table;
+        algorithm::HashTable<uint64_t, uint32_t> children;
+
+    public:
+        Lz78yTrie(size_t depth, size_t maxEntries);
+
+        /**
+         * Enters the contexts ending at sample[position - 1], each followed once by sample[position].
+         */
+        void Initialize(const uint8_t* sample, size_t position);
+
+        /**
+         * Returns the most common follower over the contexts ending at sample[idx - 1], the one of 
+         * the highest count and then of the highest value, and counts sample[idx] after each of them.
+         * The contexts missing are entered while the dictionary has room.
+         */
+        int16_t Predict(const uint8_t* sample, size_t idx);
+
+    private:
+        static uint64_t KeyOf(uint32_t node, uint8_t symbol);
+
+        uint32_t FindChild(uint32_t node, uint8_t symbol);
+        uint32_t CreateChild(uint32_t node, uint8_t symbol);
+
+        void Extend(uint32_t node, const uint8_t* sample, size_t idx, size_t length);
+    };
+}}}
+
+#endif
\ No newline at end of file
@@ -27,6 +27,7 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
@@ -35,41 +36,136 @@ namespace randomness { namespace sp800_90b { namespace estimator {
         size_t count = 0;
     } mcv_info_t;
 
+    /**
+     * Counts the symbols fed, all below Alphabet, and keeps the most common one, the highest among
+     * ties. Small alphabets are counted inline in full.
+     */
+    template <size_t Alphabet>
     class McvTracker {
     private:
-        mcv_info_t mcv;
-        std::array<size_t, 256> counter = { 0, };
+        int16_t mcvKey = -1;
+        uint32_t mcvCount = 0;
+        std::array<uint32_t, Alphabet> counts = {};
 
     public:
         void Create(uint8_t feed)
         {
-            counter[feed] = 1;
-            mcv.key = feed;
-            mcv.count = 1;
+            counts.fill(0);
+            counts[feed] = 1;
+
+            mcvKey = feed;
+            mcvCount = 1;
         }
 
         void Update(uint8_t feed) 
         {
-            counter[feed] += 1;
-            if ((mcv.count < counter[feed]) || (mcv.count == counter[feed]) && (feed > mcv.key)) {
-                mcv.key = feed;
-                mcv.count = counter[feed];
+            auto count = counts[feed] += 1;
+            if ((mcvCount < count) || ((mcvCount == count) && (feed > mcvKey))) {
+                mcvKey = feed;
+                mcvCount = count;
             }
         }
 
         mcv_info_t MostCommonValue() const
         {
+            mcv_info_t mcv;
+            mcv.key = mcvKey;
+            mcv.count = mcvCount;
             return mcv;
         }
 
         int16_t MostCommonKey() const 
         {
-            return mcv.key;
+            return mcvKey;
         }
 
         size_t MostCommonCount() const
         {
-            return mcv.count;
+            return mcvCount;
+        }
+    };
+
+    /**
+     * The first few distinct bytes are counted inline, and a full table is only allocated past 
+     * them, as most contexts of a predictor are followed by one or two symbols.
+     */
+    template <>
+    class McvTracker<256> {
+    private:
+        static constexpr size_t InlineSymbols = 4;
+
+        int16_t mcvKey = -1;
+        uint32_t mcvCount = 0;
+
+        uint8_t countSymbols = 0;
+        std::array<uint8_t, InlineSymbols> symbols;
+        std::array<uint32_t, InlineSymbols> counts;
+        std::unique_ptr<std::array<uint32_t, 256>> counter;
+
+    public:
+        void Create(uint8_t feed)
+        {
+            counter.reset();
+            countSymbols = 1;
+            symbols[0] = feed;
+            counts[0] = 1;
+
+            mcvKey = feed;
+            mcvCount = 1;
+        }
+
+        void Update(uint8_t feed) 
+        {
+            auto count = Increment(feed);
+            if ((mcvCount < count) || ((mcvCount == count) && (feed > mcvKey))) {
+                mcvKey = feed;
+                mcvCount = count;
+            }
+        }
+
+        mcv_info_t MostCommonValue() const
+        {
+            mcv_info_t mcv;
+            mcv.key = mcvKey;
+            mcv.count = mcvCount;
+            return mcv;
+        }
+
+        int16_t MostCommonKey() const 
+        {
+            return mcvKey;
+        }
+
+        size_t MostCommonCount() const
+        {
+            return mcvCount;
+        }
+
+    private:
+        uint32_t Increment(uint8_t feed)
+        {
+            if (counter != nullptr) {
+                return (*counter)[feed] += 1;
+            }
+
+            for (size_t i = 0; i < countSymbols; ++i) {
+                if (symbols[i] == feed) {
+                    return counts[i] += 1;
+                }
+            }
+
+            if (countSymbols < InlineSymbols) {
+                symbols[countSymbols] = feed;
+                counts[countSymbols] = 1;
+                countSymbols += 1;
+                return 1;
+            }
+
+            counter.reset(new std::array<uint32_t, 256>());
+            for (size_t i = 0; i < countSymbols; ++i) {
+                (*counter)[symbols[i]] = counts[i];
+            }
+            return (*counter)[feed] += 1;
         }
     };
 }}}
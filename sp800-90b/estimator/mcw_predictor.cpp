@@ -28,15 +28,43 @@
 
 using namespace randomness::sp800_90b::estimator;
 
-McwPredictorBinary::McwPredictorBinary(size_t windowSize)
+McwPredictor::McwPredictor(size_t windowSize) : windowSize(windowSize), countPushed(0)
+{
+    size_t capacity = 1;
+    while (capacity < windowSize) {
+        capacity <<= 1;
+    }
+
+    mask = capacity - 1;
+    ring.assign(capacity, 0);
+}
+
+bool McwPredictor::IsFull() const
+{
+    return countPushed >= windowSize;
+}
+
+int16_t McwPredictor::Store(uint8_t sample)
+{
+    int16_t leaving = -1;
+    if (IsFull()) {
+        leaving = ring[(countPushed - windowSize) & mask];
+    }
+
+    ring[countPushed & mask] = sample;
+    countPushed += 1;
+
+    return leaving;
+}
+
+McwPredictorBinary::McwPredictorBinary(size_t windowSize) : McwPredictor(windowSize)
 {
-    this->windowSize = windowSize;
     count.fill(0);
 }
 
 int16_t McwPredictorBinary::Predict()
 {
-    if (window.size() < windowSize) {
+    if (IsFull() == false) {
         return -1;
     }
 
@@ -45,60 +73,83 @@ int16_t McwPredictorBinary::Predict()
 
 void McwPredictorBinary::PushBack(uint8_t sample)
 {
-    window.push_back(sample);
+    auto leaving = Store(sample);
     count[sample] += 1;
 
-    if (window.size() > windowSize) {
-        count[window[0]] -= 1;
-        window.erase(window.begin());
+    if (leaving != -1) {
+        count[leaving] -= 1;
     }
 }
 
-McwPredictorLiteral::McwPredictorLiteral(size_t windowSize)
+template <size_t Alphabet>
+McwPredictorLiteral<Alphabet>::McwPredictorLiteral(size_t windowSize) : McwPredictor(windowSize)
 {
-    this->windowSize = windowSize;
+    mcv = -1;
     maxCount = 0;
     count.fill(0);
+
+    // a count reaches windowSize + 1 for a moment, before the oldest sample leaves
+    symbolsWithCount.assign(windowSize + 2, 0);
+    symbolsWithCount[0] = count.size();
 }
 
-int16_t McwPredictorLiteral::Predict()
+template <size_t Alphabet>
+int16_t McwPredictorLiteral<Alphabet>::Predict()
 {
-    if (window.size() < windowSize) {
+    if (IsFull() == false) {
         return -1;
     }
 
     return mcv;
 }
 
-void McwPredictorLiteral::PushBack(uint8_t sample)
+template <size_t Alphabet>
+void McwPredictorLiteral<Alphabet>::PushBack(uint8_t sample)
 {
-    window.push_back(sample);
-    count[sample] += 1;
-
-    if (window.size() > windowSize) {
-        auto head = window[0];
-        count[head] -= 1;
-        window.erase(window.begin());
+    auto leaving = Store(sample);
 
-        if (mcv == head) {
-            InvalidateMostCommonValue();
-        }
-    }
+    symbolsWithCount[count[sample]] -= 1;
+    count[sample] += 1;
+    symbolsWithCount[count[sample]] += 1;
 
     if (maxCount <= count[sample]) {
         mcv = sample;
         maxCount = count[sample];
     }
+
+    if (leaving == -1) {
+        return;
+    }
+
+    symbolsWithCount[count[leaving]] -= 1;
+    count[leaving] -= 1;
+    symbolsWithCount[count[leaving]] += 1;
+
+    if (mcv == leaving) {
+        InvalidateMostCommonValue();
+    }
 }
 
-void McwPredictorLiteral::InvalidateMostCommonValue() 
+/**
+ * Only the most common value leaving the window lowers the highest count, by one at most. The 
+ * prediction is then the first symbol with that count walking back from the newest sample, 
+ * which is not far on the average, as the walk only happens when that symbol leaves.
+ */
+template <size_t Alphabet>
+void McwPredictorLiteral<Alphabet>::InvalidateMostCommonValue() 
 {
-    maxCount = *std::max_element(count.begin(), count.end());
-    
-    auto iter = window.rbegin();
-    while (count[*iter] != maxCount) {
-        std::advance(iter, 1);
+    if (symbolsWithCount[maxCount] == 0) {
+        maxCount -= 1;
     }
 
-    mcv = *iter;
-}
\ No newline at end of file
+    auto i = countPushed - 1;
+    while (count[ring[i & mask]] != maxCount) {
+        --i;
+    }
+
+    mcv = ring[i & mask];
+}
+
+template class randomness::sp800_90b::estimator::McwPredictorLiteral<4>;
+template class randomness::sp800_90b::estimator::McwPredictorLiteral<16>;
+template class randomness::sp800_90b::estimator::McwPredictorLiteral<256>;
\ No newline at end of file
@@ -33,17 +33,30 @@
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
+    /**
+     * The window is a ring buffer of a power-of-two capacity, holding the last windowSize samples.
+     */
     class McwPredictor {
     protected:
         size_t windowSize;
-        std::vector<uint8_t> window;
+        size_t countPushed;
+        size_t mask;
+        std::vector<uint8_t> ring;
 
     public:
         virtual int16_t Predict() = 0;
         virtual void PushBack(uint8_t sample) = 0;
+
+    protected:
+        McwPredictor(size_t windowSize);
+
+        bool IsFull() const;
+
+        // stores the sample over the one leaving the window, which is returned once the window is full
+        int16_t Store(uint8_t sample);
     };
 
-    class McwPredictorBinary : public McwPredictor 
+    class McwPredictorBinary final : public McwPredictor 
     {
     private:
         std::array<size_t, 2> count;
@@ -54,12 +67,19 @@ namespace randomness { namespace sp800_90b { namespace estimator {
         void PushBack(uint8_t sample) override;
     };
     
-    class McwPredictorLiteral : public McwPredictor 
+    /**
+     * Predicts the most common value in the window, the most recent one among ties. The number of 
+     * symbols at each count keeps the highest count up to date as samples come and go. The 
+     * samples are below Alphabet.
+     */
+    template <size_t Alphabet>
+    class McwPredictorLiteral final : public McwPredictor 
     {
     private:
         int16_t mcv;
         size_t maxCount;
-        std::array<size_t, 256> count;
+        std::array<size_t, Alphabet> count;
+        std::vector<size_t> symbolsWithCount;
 
     public:
         McwPredictorLiteral(size_t windowSize);
@@ -36,101 +36,73 @@ void MmcPredictor::Initialize(const uint8_t* sample, size_t order)
     entries = 0;
 }
 
-void MmcPredictorBinary::Initialize(const uint8_t* sample, size_t order)
+template <size_t Alphabet>
+void MmcPredictorLiteral<Alphabet>::Initialize(const uint8_t* sample, size_t order)
 {
     MmcPredictor::Initialize(sample, order);
 
-    mask = 0;
+    auto bits = SymbolBits * order;
+    mask = (bits < 8 * sizeof(trace_t)) ? (static_cast<trace_t>(1) << bits) - 1 : ~static_cast<trace_t>(0);
     trace = 0;
     for (auto d = 0; d < order; ++d) {
-        mask = (mask << 1) ^ 0x1;
-        trace = (trace << 1) ^ sample[d];
+        UpdateTrace(sample[d]);
     }
 
-    chain.resize(1 << (order + 1));
+    direct = (bits <= 16);
+    table = std::vector<McvTracker<Alphabet>>(direct ? static_cast<size_t>(1) << bits : 0);
+    chain.Clear();
     CreateEntry(sample[order]);
 }
 
-
-int16_t MmcPredictorBinary::Predict(uint8_t sample)
+template <size_t Alphabet>
+int16_t MmcPredictorLiteral<Alphabet>::Predict(uint8_t sample)
 {
-    size_t idx = static_cast<size_t>(trace) << 1;
-    int16_t prediction = (chain[idx] > chain[idx ^ 1]) ? 0 : 1;
-
-    if (chain[idx ^ prediction] == 0) {
-        prediction = -1;
+    auto tracker = FindTracker();
+    if (tracker == nullptr) {
         CreateEntry(sample);
-    } 
-    else {
-        chain[idx ^ sample] += 1;
-        UpdateTrace(sample);
+        return -1;
     }
 
+    auto prediction = tracker->MostCommonKey();
+    tracker->Update(sample);
+    UpdateTrace(sample);
+
     return prediction;
 }
 
-void MmcPredictorBinary::CreateEntry(uint8_t sample)
+// an existing context starts over
+template <size_t Alphabet>
+void MmcPredictorLiteral<Alphabet>::CreateEntry(uint8_t sample)
 {
     if (entries >= MaxEntries) {
         return;
     }
 
-    size_t idx = static_cast<size_t>(trace) << 1;
-
-    chain[idx ^ sample] = 1;
+    auto& tracker = direct ? table[static_cast<size_t>(trace)] : chain[trace];
+    tracker.Create(sample);
     entries += 1;
 
     UpdateTrace(sample);
 }
 
-void MmcPredictorBinary::UpdateTrace(uint8_t sample)
-{
-    trace = (trace << 1) ^ sample;
-    trace &= mask;
-}
-
-void MmcPredictorLiteral::Initialize(const uint8_t* sample, size_t order)
-{
-    MmcPredictor::Initialize(sample, order);
-
-    trace.assign(sample, sample + order);
-    
-    chain.clear();
-    CreateEntry(sample[order]);
-}
-
-int16_t MmcPredictorLiteral::Predict(uint8_t sample)
+template <size_t Alphabet>
+void MmcPredictorLiteral<Alphabet>::UpdateTrace(uint8_t sample)
 {
-    int16_t prediction = -1;
-
-    auto iter = chain.find(trace);
-    if (iter != chain.end()) {
-        prediction = iter->second.MostCommonKey();
-        iter->second.Update(sample);
-        UpdateTrace(sample);
-    }
-    else {
-        CreateEntry(sample);
-    }
-
-    return prediction;
+    trace = ((trace << SymbolBits) | sample) & mask;
 }
 
-void MmcPredictorLiteral::CreateEntry(uint8_t sample)
+// a context in the table has been seen once it has a count
+template <size_t Alphabet>
+McvTracker<Alphabet>* MmcPredictorLiteral<Alphabet>::FindTracker()
 {
-    if (entries >= MaxEntries) {
-        return;
+    if (direct == false) {
+        return chain.Find(trace);
     }
 
-    chain[trace] = McvTracker();
-    chain[trace].Create(sample);
-    entries += 1;
-
-    UpdateTrace(sample);
+    auto& tracker = table[static_cast<size_t>(trace)];
+    return (tracker.MostCommonCount() > 0) ? &tracker : nullptr;
 }
 
-void MmcPredictorLiteral::UpdateTrace(uint8_t sample)
-{
-    trace.push_back(sample);
-    trace.erase(trace.begin());
-}
\ No newline at end of file
+template class randomness::sp800_90b::estimator::MmcPredictorLiteral<4>;
+template class randomness::sp800_90b::estimator::MmcPredictorLiteral<16>;
+template class randomness::sp800_90b::estimator::MmcPredictorLiteral<256>;
\ No newline at end of file
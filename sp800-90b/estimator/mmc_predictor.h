@@ -26,10 +26,11 @@
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_MMC_PREDICTOR_H__
 
 #include <cstdint>
-#include <map>
+#include <type_traits>
 #include <vector>
 
 #include "mcv_tracker.h"
+#include "../../algorithm/hash_table.h"
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
@@ -47,32 +48,40 @@ namespace randomness { namespace sp800_90b { namespace estimator {
         virtual void UpdateTrace(uint8_t sample) = 0;
     };
 
-    class MmcPredictorBinary : public MmcPredictor 
+    /**
+     * For samples below Alphabet, one of 4, 16 and 256. The context of up to 16 symbols is packed 
+     * into a trace of SymbolBits per symbol, newest symbol lowest, which fits 64 bits below 256 
+     * symbols and takes 128 bits otherwise. The orders of at most 2^16 contexts are counted in a 
+     * table indexed by the trace, as they never reach the entry limit, and the others in a hash table.
+     */
+    template <size_t Alphabet>
+    class MmcPredictorLiteral final : public MmcPredictor 
     {
-    using trace_t = uint16_t;
-    using chain_t = std::vector<size_t>;
+    static_assert((Alphabet == 4) || (Alphabet == 16) || (Alphabet == 256), "unsupported alphabet size");
 
-    private:
-        trace_t mask;
-        trace_t trace;
-        chain_t chain;
+    static constexpr size_t SymbolBits = __builtin_ctz(Alphabet);
 
-    public:
-        void Initialize(const uint8_t* sample, size_t order) override;
-        int16_t Predict(uint8_t sample) override;
-        void CreateEntry(uint8_t sample) override;
-    
-    private:
-        void UpdateTrace(uint8_t sample) override;
+    using trace_t = typename std::conditional<(SymbolBits <= 4), uint64_t, unsigned __int128>::type;
+
+    struct TraceHash {
+        uint64_t operator()(uint64_t trace) const
+        {
+            return algorithm::MixBits(trace);
+        }
+
+        uint64_t operator()(unsigned __int128 trace) const
+        {
+            return algorithm::MixBits(static_cast<uint64_t>(trace) ^ algorithm::MixBits(static_cast<uint64_t>(trace >> 64)));
+        }
     };
-    
-    class MmcPredictorLiteral : public MmcPredictor 
-    {
-    using trace_t = std::vector<uint8_t>;
-    using chain_t = std::map<trace_t, McvTracker>;
+
+    using chain_t = algorithm::HashTable<trace_t, McvTracker<Alphabet>, TraceHash>;
 
     private:
+        trace_t mask;
         trace_t trace;
+        bool direct;
+        std::vector<McvTracker<Alphabet>> table;
         chain_t chain;
 
     public:
@@ -82,6 +91,8 @@ namespace randomness { namespace sp800_90b { namespace estimator {
         
     private:
         void UpdateTrace(uint8_t sample) override;
+
+        McvTracker<Alphabet>* FindTracker();
     };
 }}}
 
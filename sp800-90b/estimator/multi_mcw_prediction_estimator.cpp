@@ -24,47 +24,60 @@
 
 #include "multi_mcw_prediction_estimator.h"
 
-#include <algorithm>
-#include <vector>
+#include <array>
 
 using namespace randomness::sp800_90b::estimator;
 
-static constexpr std::array<size_t, 4> WindowSize = {63, 255, 1023, 4095};
+static constexpr std::array<size_t, MultiMcwPredictionEstimator::CountPredictors> WindowSize = {63, 255, 1023, 4095};
+
+MultiMcwPredictionEstimator::MultiMcwPredictionEstimator(size_t countThreads) : PredictionEngine(countThreads) 
+{
+}
 
 std::string MultiMcwPredictionEstimator::Name() const
 {
     return "MultiMCW Prediction Estimate";
 }
 
-void MultiMcwPredictionEstimator::Initialize()
+void MultiMcwPredictionEstimator::MakePredictions()
 {
     startPredictionIndex = WindowSize[0];
     countPredictions = countSamples - startPredictionIndex;
 
-    prediction.assign(4, -1);
-    scoreboard.assign(4, 0);
-
-    mcw.clear();
-    for (auto i = 0; i < 4; ++i) {
-        if (countAlphabets == 2) {
-            mcw.push_back(std::make_shared<McwPredictorBinary>(WindowSize[i]));
-        }
-        else {
-            mcw.push_back(std::make_shared<McwPredictorLiteral>(WindowSize[i]));
-        }
+    if (countAlphabets == 2) {
+        MakePredictions<McwPredictorBinary>();
     }
-
-    for (auto i = 0; i < WindowSize[0]; ++i) {
-        for (auto& window : mcw) {
-            window->PushBack(sample[i]);
-        }
+    else if (countAlphabets <= 4) {
+        MakePredictions<McwPredictorLiteral<4>>();
+    }
+    else if (countAlphabets <= 16) {
+        MakePredictions<McwPredictorLiteral<16>>();
+    }
+    else {
+        MakePredictions<McwPredictorLiteral<256>>();
     }
 }
 
-void MultiMcwPredictionEstimator::UpdatePredictions(size_t idx)
+// a window only depends on the samples it holds, so it can be filled again at any position
+template <typename Predictor>
+void MultiMcwPredictionEstimator::MakePredictions()
 {
-    for (auto j = 0; j < 4; ++j) {
-        prediction[j] = mcw[j]->Predict();
-        mcw[j]->PushBack(sample[idx]);
-    }
+    RunParallel([this](size_t begin) {
+        auto mcw = std::vector<Predictor>();
+        for (auto size : WindowSize) {
+            mcw.emplace_back(size);
+            for (auto i = (begin > size) ? begin - size : 0; i < begin; ++i) {
+                mcw.back().PushBack(sample[i]);
+            }
+        }
+
+        return [this, mcw](size_t idx) mutable {
+            predictions_t predictions;
+            for (auto j = 0; j < CountPredictors; ++j) {
+                predictions[j] = mcw[j].Predict();
+                mcw[j].PushBack(sample[idx]);
+            }
+            return Match(predictions, sample[idx]);
+        };
+    });
 }
\ No newline at end of file
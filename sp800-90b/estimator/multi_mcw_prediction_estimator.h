@@ -25,27 +25,26 @@
 #ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_MULTI_MCW_H__
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_MULTI_MCW_H__
 
-#include "prediction_estimator.h"
+#include "prediction_engine.h"
 
-#include <array>
-#include <memory>
 #include <vector>
 
 #include "mcw_predictor.h"
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
-    class MultiMcwPredictionEstimator : public PredictionEstimator 
+    class MultiMcwPredictionEstimator : public PredictionEngine<4> 
     {
-    private:
-        std::vector<std::shared_ptr<McwPredictor>> mcw;
-
     public:
+        explicit MultiMcwPredictionEstimator(size_t countThreads = 1);
+
         std::string Name() const override;
 
     private:
-        void Initialize() override;
-        void UpdatePredictions(size_t idx) override;
+        void MakePredictions() override;
+
+        template <typename Predictor>
+        void MakePredictions();
     };
 }}}
 
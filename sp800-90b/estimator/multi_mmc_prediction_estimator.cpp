@@ -24,49 +24,89 @@
 
 #include "multi_mmc_prediction_estimator.h"
 
-using namespace randomness::sp800_90b::estimator;
+#include <algorithm>
 
-static constexpr size_t CountPredictors = 16;
+using namespace randomness::sp800_90b::estimator;
 
 std::string MultiMmcPredictionEstimator::Name() const
 {
     return "MultiMMC Prediction Estimate";
 }
 
-void MultiMmcPredictionEstimator::Initialize()
+void MultiMmcPredictionEstimator::MakePredictions()
 {
     startPredictionIndex = 2;
     countPredictions = countSamples - startPredictionIndex;
 
-    prediction.assign(CountPredictors, -1);
-    scoreboard.assign(CountPredictors, 0);
-
-    mmc.clear();
-    for (auto d = 0; d < CountPredictors; ++d) {
-        if (countAlphabets == 2) {
-            mmc.push_back(std::make_shared<MmcPredictorBinary>());
-        }
-        else {
-            mmc.push_back(std::make_shared<MmcPredictorLiteral>());
-        }
-        mmc[d]->Initialize(sample, d + 1);
+    if (countAlphabets == 2) {
+        MakeBinaryPredictions();
+    }
+    else if (countAlphabets <= 4) {
+        MakePredictions<MmcPredictorLiteral<4>>();
+    }
+    else if (countAlphabets <= 16) {
+        MakePredictions<MmcPredictorLiteral<16>>();
+    }
+    else {
+        MakePredictions<MmcPredictorLiteral<256>>();
     }
 }
 
-void MultiMmcPredictionEstimator::UpdatePredictions(size_t idx)
+/**
+ * All orders are counted in one table. An order d context has been seen before exactly when its 
+ * counts are not both zero, and then so has every shorter one. At most 2^16 contexts per order 
+ * never reach the entry limit, so every context following the first unseen one is counted too.
+ */
+void MultiMmcPredictionEstimator::MakeBinaryPredictions()
 {
-    auto min = std::min(CountPredictors, idx - 1);
-    auto feed = sample[idx];
+    BinaryContextTable table;
+    for (size_t d = 0; d < CountPredictors; ++d) {
+        table.Load(sample, d + 1);
+        table.Follows(d + 1)[sample[d + 1]] = 1;
+    }
+    table.Load(sample, startPredictionIndex);
 
-    for (auto d = 0; d < min; ++d) {
-        prediction[d] = mmc[d]->Predict(feed);
-        
-        if (prediction[d] == -1) {
-            for (auto i = d + 1; i < min; ++i) {
-                mmc[i]->CreateEntry(feed);
+    Run([&](size_t idx) {
+        auto min = std::min(CountPredictors, idx - 1);
+        auto feed = sample[idx];
+        auto seen = true;
+
+        for (size_t d = 0; d < min; ++d) {
+            auto follows = table.Follows(d + 1);
+
+            if (seen) {
+                seen = (follows[0] | follows[1]) != 0;
+                prediction[d] = seen ? (follows[1] >= follows[0]) : -1;
             }
-            break;
+            follows[feed] += 1;
         }
-    }
+
+        table.Push(feed);
+    });
 }
 
+// a subpredictor that has not seen its context yet leaves the higher orders only to learn it
+template <typename Predictor>
+void MultiMmcPredictionEstimator::MakePredictions()
+{
+    std::vector<Predictor> mmc(CountPredictors);
+    for (auto d = 0; d < CountPredictors; ++d) {
+        mmc[d].Initialize(sample, d + 1);
+    }
+
+    Run([&](size_t idx) {
+        auto min = std::min(CountPredictors, idx - 1);
+        auto feed = sample[idx];
+
+        for (auto d = 0; d < min; ++d) {
+            prediction[d] = mmc[d].Predict(feed);
+            
+            if (prediction[d] == -1) {
+                for (auto i = d + 1; i < min; ++i) {
+                    mmc[i].CreateEntry(feed);
+                }
+                break;
+            }
+        }
+    });
+}
@@ -25,26 +25,26 @@
 #ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_MULTI_MMC_H__
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_MULTI_MMC_H__
 
-#include "prediction_estimator.h"
+#include "prediction_engine.h"
 
-#include <array>
-#include <memory>
+#include <vector>
 
+#include "binary_context_table.h"
 #include "mmc_predictor.h"
 
 namespace randomness { namespace sp800_90b { namespace estimator {
 
-    class MultiMmcPredictionEstimator : public PredictionEstimator 
+    class MultiMmcPredictionEstimator : public PredictionEngine<16> 
     {
-    private:
-        std::vector<std::shared_ptr<MmcPredictor>> mmc;
-
     public:
         std::string Name() const override;
     
     private:
-        void Initialize() override;
-        void UpdatePredictions(size_t idx) override;
+        void MakePredictions() override;
+        void MakeBinaryPredictions();
+
+        template <typename Predictor>
+        void MakePredictions();
     };
 }}}
 
@@ -0,0 +1,271 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "online_tuple_statistics.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace randomness::sp800_90b::estimator;
+
+static constexpr uint32_t None = UINT32_MAX;
+
+// above this many edges, a state moves them from its list into a table
+static constexpr uint32_t ListDegree = 8;
+
+OnlineTupleStatistics::OnlineTupleStatistics(size_t refreshInterval) 
+    : last(0), length(0), max_lcp(0), refresh_interval(refreshInterval), refreshed_length(0)
+{
+    if (refreshInterval == 0) {
+        throw std::invalid_argument("the refresh interval must be positive");
+    }
+
+    AddState(0, 0, None);
+    statistics = Count();
+}
+
+uint32_t OnlineTupleStatistics::AddState(size_t len, size_t positions, uint32_t link)
+{
+    // a sample of n symbols has at most 2n - 1 states, and their indices stay below None
+    if (states.size() >= None) {
+        throw std::runtime_error("the sample is too long for the online tuple statistics");
+    }
+
+    states.push_back({len, positions, link, None, 0, None});
+    return static_cast<uint32_t>(states.size() - 1);
+}
+
+uint32_t OnlineTupleStatistics::Find(uint32_t state, uint8_t symbol) const
+{
+    if (states[state].table != None) {
+        return tables[states[state].table][symbol];
+    }
+
+    for (auto e = states[state].edges; e != None; e = edges[e].next) {
+        if (edges[e].symbol == symbol) {
+            return edges[e].target;
+        }
+    }
+    return None;
+}
+
+void OnlineTupleStatistics::AddEdge(uint32_t state, uint8_t symbol, uint32_t target)
+{
+    auto& s = states[state];
+    if (s.table != None) {
+        tables[s.table][symbol] = target;
+        return;
+    }
+
+    edges.push_back({target, s.edges, symbol});
+    s.edges = static_cast<uint32_t>(edges.size() - 1);
+    s.degree += 1;
+
+    if (s.degree > ListDegree) {
+        tables.emplace_back();
+        tables.back().fill(None);
+        for (auto e = s.edges; e != None; e = edges[e].next) {
+            tables.back()[edges[e].symbol] = edges[e].target;
+        }
+        s.table = static_cast<uint32_t>(tables.size() - 1);
+    }
+}
+
+void OnlineTupleStatistics::Redirect(uint32_t state, uint8_t symbol, uint32_t target)
+{
+    if (states[state].table != None) {
+        tables[states[state].table][symbol] = target;
+        return;
+    }
+
+    for (auto e = states[state].edges; e != None; e = edges[e].next) {
+        if (edges[e].symbol == symbol) {
+            edges[e].target = target;
+            return;
+        }
+    }
+}
+
+// the usual online construction, where the new state owns the position of the new symbol and a clone owns none
+void OnlineTupleStatistics::Extend(uint8_t symbol)
+{
+    auto current = AddState(states[last].len + 1, 1, None);
+    auto p = last;
+
+    while ((p != None) && (Find(p, symbol) == None)) {
+        AddEdge(p, symbol, current);
+        p = states[p].link;
+    }
+
+    if (p == None) {
+        states[current].link = 0;
+    }
+    else {
+        auto q = Find(p, symbol);
+        if (states[p].len + 1 == states[q].len) {
+            states[current].link = q;
+        }
+        else {
+            auto clone = AddState(states[p].len + 1, 0, states[q].link);
+            if (states[q].table != None) {
+                tables.push_back(tables[states[q].table]);
+                states[clone].table = static_cast<uint32_t>(tables.size() - 1);
+            }
+            else {
+                for (auto e = states[q].edges; e != None; e = edges[e].next) {
+                    AddEdge(clone, edges[e].symbol, edges[e].target);
+                }
+            }
+
+            while ((p != None) && (Find(p, symbol) == q)) {
+                Redirect(p, symbol, clone);
+                p = states[p].link;
+            }
+
+            states[q].link = clone;
+            states[current].link = clone;
+        }
+    }
+
+    last = current;
+}
+
+/**
+ * The new symbol ends one more occurrence of every suffix of the sample, which are the states on 
+ * the suffix links from the new one. Counting them here would walk the whole chain, as long as 
+ * the sample on periodic data, so only the longest repeated suffix is noted.
+ */
+void OnlineTupleStatistics::Push(uint8_t symbol)
+{
+    Extend(symbol);
+
+    length += 1;
+
+    auto state = states[last].link;
+    if (state != 0) {
+        max_lcp = std::max(max_lcp, states[state].len);
+    }
+}
+
+void OnlineTupleStatistics::Push(const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        Push(data[i]);
+    }
+}
+
+size_t OnlineTupleStatistics::Length() const
+{
+    return length;
+}
+
+size_t OnlineTupleStatistics::MaxLcp() const
+{
+    return max_lcp;
+}
+
+/**
+ * A state occurs at the positions it owns and those of every state linking to it, so the counts 
+ * are gathered from the longest states down. Every tuple of a state shares its count c, which adds 
+ * c(c - 1)/2 pairs to S over the range of its lengths, kept as differences over t. A t-tuple 
+ * occurs at least as often as any longer tuple it starts, so Q is a running maximum from the top.
+ */
+TupleStatistics OnlineTupleStatistics::Count() const
+{
+    std::vector<uint32_t> order(states.size());
+    std::vector<size_t> starts(length + 2, 0);
+    for (const auto& s : states) {
+        starts[s.len + 1] += 1;
+    }
+    for (size_t len = 1; len < starts.size(); ++len) {
+        starts[len] += starts[len - 1];
+    }
+    for (uint32_t state = 0; state < states.size(); ++state) {
+        order[starts[states[state].len]++] = state;
+    }
+
+    std::vector<size_t> counts(states.size());
+    for (uint32_t state = 0; state < states.size(); ++state) {
+        counts[state] = states[state].positions;
+    }
+
+    std::vector<int64_t> pair_deltas(max_lcp + 2, 0);
+    std::vector<size_t> maximum_counts(max_lcp + 1, 1);
+
+    for (auto i = order.size(); i-- > 1;) {
+        auto state = order[i];
+        const auto& s = states[state];
+        auto count = counts[state];
+        counts[s.link] += count;
+
+        // tuples seen once add no pairs, and only those seen twice are at most max_lcp long
+        if (count < 2) {
+            continue;
+        }
+
+        auto pairs = static_cast<int64_t>(count * (count - 1) / 2);
+        pair_deltas[states[s.link].len + 1] += pairs;
+        pair_deltas[s.len + 1] -= pairs;
+        maximum_counts[s.len] = std::max(maximum_counts[s.len], count);
+    }
+
+    TupleStatistics statistics;
+    statistics.length = length;
+    statistics.max_lcp = max_lcp;
+    statistics.Q.assign(max_lcp + 1, 1);
+    statistics.S.assign(max_lcp + 1, 0);
+
+    int64_t pairs = 0;
+    for (size_t t = 1; t <= max_lcp; ++t) {
+        pairs += pair_deltas[t];
+        statistics.S[t] = static_cast<size_t>(pairs);
+    }
+
+    size_t count = 1;
+    for (auto t = max_lcp; t > 0; --t) {
+        count = std::max(count, maximum_counts[t]);
+        statistics.Q[t] = count;
+    }
+
+    return statistics;
+}
+
+const TupleStatistics& OnlineTupleStatistics::Statistics()
+{
+    if (length - refreshed_length >= refresh_interval) {
+        Refresh();
+    }
+
+    return statistics;
+}
+
+const TupleStatistics& OnlineTupleStatistics::Refresh()
+{
+    if (refreshed_length != length) {
+        statistics = Count();
+        refreshed_length = length;
+    }
+
+    return statistics;
+}
\ No newline at end of file
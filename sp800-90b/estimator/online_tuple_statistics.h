@@ -0,0 +1,110 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_ONLINE_TUPLE_STATISTICS_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_ONLINE_TUPLE_STATISTICS_H__
+
+#include "tuple_statistics.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    /**
+     * Takes symbols one at a time into a suffix automaton of the sample so far, in amortized 
+     * constant time each. Each state stands for the substrings with the same end positions, whose 
+     * lengths form the range (len[link], len]. Only the state a symbol creates owns its position; 
+     * the others get theirs from the suffix link tree when the counts are refreshed.
+     *
+     * Unlike Push(), a refresh is not incremental: it costs O(Length()), so refreshing after every 
+     * symbol is quadratic over a stream. Keeping Q and S exact per symbol would need path updates 
+     * on the suffix link tree, where every state adds its own count over its own range of lengths. 
+     * A monitor instead refreshes every refreshInterval symbols, which costs O(Length() / interval) 
+     * per symbol, and reads the cached counts in between.
+     */
+    class OnlineTupleStatistics {
+    private:
+        struct state_t {
+            size_t len;
+            size_t positions;
+            uint32_t link;
+            uint32_t edges;
+            uint32_t degree;
+            uint32_t table;
+        };
+
+        struct edge_t {
+            uint32_t target;
+            uint32_t next;
+            uint8_t symbol;
+        };
+
+        std::vector<state_t> states;
+        std::vector<edge_t> edges;
+
+        // states close to the root see most symbols, and look them up in a table instead
+        std::vector<std::array<uint32_t, 256>> tables;
+        uint32_t last;
+
+        size_t length;
+        size_t max_lcp;
+
+        // the counts as of refreshed_length symbols
+        size_t refresh_interval;
+        size_t refreshed_length;
+        TupleStatistics statistics;
+
+    public:
+        explicit OnlineTupleStatistics(size_t refreshInterval = 1);
+
+        void Push(uint8_t symbol);
+        void Push(const uint8_t* data, size_t length);
+
+        size_t Length() const;
+        size_t MaxLcp() const;
+
+        /**
+         * The same counts as TupleStatistics::Create() over the first Statistics().Length() 
+         * symbols, refreshed once refreshInterval symbols were pushed since the last refresh.
+         */
+        const TupleStatistics& Statistics();
+
+        /**
+         * Refreshes the counts over every symbol pushed so far, unless nothing was pushed since.
+         */
+        const TupleStatistics& Refresh();
+
+    private:
+        uint32_t AddState(size_t len, size_t positions, uint32_t link);
+        uint32_t Find(uint32_t state, uint8_t symbol) const;
+        void AddEdge(uint32_t state, uint8_t symbol, uint32_t target);
+        void Redirect(uint32_t state, uint8_t symbol, uint32_t target);
+        void Extend(uint8_t symbol);
+        TupleStatistics Count() const;
+    };
+}}}
+
+#endif
\ No newline at end of file
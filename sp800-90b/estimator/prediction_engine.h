@@ -0,0 +1,287 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_ENGINE_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_PREDICTION_ENGINE_H__
+
+#include "prediction_estimator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    /**
+     * Runs a fixed number of subpredictors over the sample in blocks. The subpredictors of a block
+     * are updated first, then every prediction is checked against its sample into a bit per 
+     * subpredictor, and the scoreboard and the runs are kept from those bits alone.
+     */
+    template <size_t Count>
+    class PredictionEngine : public PredictionEstimator 
+    {
+    public:
+        static constexpr size_t CountPredictors = Count;
+
+    protected:
+        static constexpr size_t CountWords = (CountPredictors + 63) / 64;
+        using predictions_t = std::array<int16_t, CountPredictors>;
+        using hits_t = std::array<uint64_t, CountWords>;
+
+        // the hits of a block are kept within about 32 KiB
+        static constexpr size_t BlockLength = (1 << 15) / sizeof(hits_t);
+
+        // samples each thread predicts between two scans in RunParallel()
+        static constexpr size_t ChunkLength = 1 << 16;
+
+        size_t countThreads;
+        size_t winner = 0;
+        predictions_t prediction;
+        std::array<size_t, CountPredictors> scoreboard;
+
+        /**
+         * When most subpredictors hit on every sample, the scoreboard is kept as bit planes instead,
+         * planes[b] holding bit b of every score, and is moved a word of subpredictors at a time.
+         */
+        bool slicedScoreboard = false;
+        size_t winnerScore;
+        std::vector<hits_t> planes;
+
+    public:
+        explicit PredictionEngine(size_t countThreads = 1) : countThreads(countThreads) {}
+
+    protected:
+        /**
+         * Calls update(idx) for every sample from startPredictionIndex on, which sets prediction 
+         * to the guesses of the subpredictors for sample[idx].
+         */
+        template <typename Update>
+        void Run(Update update)
+        {
+            Reset();
+
+            auto hits = std::vector<hits_t>(BlockLength);
+
+            for (auto begin = startPredictionIndex; begin < countSamples; begin += BlockLength) {
+                auto count = std::min(BlockLength, countSamples - begin);
+
+                for (size_t k = 0; k < count; ++k) {
+                    update(begin + k);
+                    hits[k] = Match(prediction, sample[begin + k]);
+                }
+
+                Score(hits.data(), count);
+            }
+        }
+
+        /**
+         * For subpredictors that only look back at the sample, never at the scoreboard. start(begin)
+         * returns a matcher primed with the samples before begin, which is then called as 
+         * match(idx) for idx = begin, begin + 1, ... in turn and returns the hits on sample[idx].
+         * The threads match one chunk each, and the scoreboard is then kept over all of them in order.
+         */
+        template <typename Start>
+        void RunParallel(Start start)
+        {
+            Reset();
+
+            auto stride = countThreads * ChunkLength;
+            auto hits = std::vector<hits_t>(stride);
+
+            for (auto begin = startPredictionIndex; begin < countSamples; begin += stride) {
+                auto end = std::min(begin + stride, countSamples);
+
+                #pragma omp parallel for num_threads(countThreads) schedule(static, 1) if (countThreads > 1)
+                for (size_t c = 0; c < countThreads; ++c) {
+                    auto first = begin + c * ChunkLength;
+                    auto last = std::min(first + ChunkLength, end);
+                    if (first >= last) {
+                        continue;
+                    }
+
+                    auto match = start(first);
+                    for (auto idx = first; idx < last; ++idx) {
+                        hits[idx - begin] = match(idx);
+                    }
+                }
+
+                Score(hits.data(), end - begin);
+            }
+        }
+
+        void Reset()
+        {
+            winner = 0;
+            prediction.fill(-1);
+            scoreboard.fill(0);
+
+            winnerScore = 0;
+            planes.clear();
+        }
+
+        // 8 bytes as a word, the first one lowest whatever the byte order of the machine
+        static uint64_t LoadLittleEndian(const uint8_t* bytes)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            word = __builtin_bswap64(word);
+#endif
+            return word;
+        }
+
+        /**
+         * The comparisons are made into bytes first, which vectorizes, and every 8 of them are 
+         * then gathered into the top byte of one multiplication.
+         */
+        static hits_t Match(const predictions_t& predictions, uint8_t feed)
+        {
+            std::array<uint8_t, CountWords * 64> equal = { 0, };
+            for (size_t j = 0; j < CountPredictors; ++j) {
+                equal[j] = (predictions[j] == feed);
+            }
+
+            hits_t hits;
+            for (size_t w = 0; w < CountWords; ++w) {
+                uint64_t bits = 0;
+                for (size_t g = 0; g < 64; g += 8) {
+                    auto bytes = LoadLittleEndian(equal.data() + w * 64 + g);
+                    bits |= ((bytes * 0x0102040810204080) >> 56) << g;
+                }
+                hits[w] = bits;
+            }
+
+            return hits;
+        }
+
+        static bool IsHit(const hits_t& hits, size_t j)
+        {
+            return (hits[j / 64] >> (j % 64)) & 1;
+        }
+
+        static bool IsEmpty(const hits_t& hits)
+        {
+            uint64_t any = 0;
+            for (auto bits : hits) {
+                any |= bits;
+            }
+            return any == 0;
+        }
+
+        void Score(const hits_t* hits, size_t count)
+        {
+            if (slicedScoreboard) {
+                ScoreSliced(hits, count);
+            }
+            else {
+                ScoreSparse(hits, count);
+            }
+        }
+
+        // the winner is checked before the scoreboard moves, and takes ties in favour of later subpredictors
+        void ScoreSparse(const hits_t* hits, size_t count)
+        {
+            // kept local, as the compiler cannot tell the member apart from the scoreboard
+            auto best = winner;
+
+            for (size_t k = 0; k < count; ++k) {
+                CountPrediction(IsHit(hits[k], best));
+
+                for (size_t w = 0; w < CountWords; ++w) {
+                    for (auto bits = hits[k][w]; bits != 0; bits &= bits - 1) {
+                        auto j = w * 64 + __builtin_ctzll(bits);
+                        scoreboard[j] += 1;
+
+                        if (scoreboard[j] >= scoreboard[best]) {
+                            best = j;
+                        }
+                    }
+                }
+            }
+
+            winner = best;
+        }
+
+        /**
+         * Walking the hits in order, each one takes over the winner on a score at least as high. 
+         * That leaves the last of the hits with the highest score, unless it stays below the 
+         * previous winner, which then keeps its place.
+         */
+        void ScoreSliced(const hits_t* hits, size_t count)
+        {
+            for (size_t k = 0; k < count; ++k) {
+                CountPrediction(IsHit(hits[k], winner));
+                if (IsEmpty(hits[k])) {
+                    continue;
+                }
+
+                // every hit score goes up by one, with the carries rippling up the planes
+                auto carry = hits[k];
+                for (size_t b = 0; IsEmpty(carry) == false; ++b) {
+                    if (b == planes.size()) {
+                        planes.emplace_back();
+                        planes.back().fill(0);
+                    }
+
+                    for (size_t w = 0; w < CountWords; ++w) {
+                        auto next = planes[b][w] & carry[w];
+                        planes[b][w] ^= carry[w];
+                        carry[w] = next;
+                    }
+                }
+
+                // narrowed from the top plane down to the hits with the highest score
+                auto best = hits[k];
+                for (auto b = planes.size(); b-- > 0;) {
+                    hits_t narrowed;
+                    for (size_t w = 0; w < CountWords; ++w) {
+                        narrowed[w] = best[w] & planes[b][w];
+                    }
+
+                    if (IsEmpty(narrowed) == false) {
+                        best = narrowed;
+                    }
+                }
+
+                auto w = CountWords;
+                while (best[--w] == 0) {}
+                auto j = w * 64 + 63 - __builtin_clzll(best[w]);
+
+                size_t score = 0;
+                for (size_t b = 0; b < planes.size(); ++b) {
+                    score |= static_cast<size_t>(IsHit(planes[b], j)) << b;
+                }
+
+                if (score >= winnerScore) {
+                    winner = j;
+                    winnerScore = score;
+                }
+            }
+        }
+    };
+}}}
+
+#endif
\ No newline at end of file
@@ -25,7 +25,9 @@
 #include "prediction_estimator.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <vector>
 
 #include "binary_search.h"
 #include "boundary.h"
@@ -35,60 +37,103 @@ using namespace randomness::sp800_90b::estimator;
 
 static const double LogAlpha = log(0.99);
 
-double PredictionEstimator::Estimate() 
+/**
+ * Maps the symbols in use onto 0, 1, ... in their order, which keeps every comparison of the 
+ * predictors, their tie-breaks included, and returns how many there are. The sample is only 
+ * copied into compacted when they are not already the lowest ones.
+ */
+static size_t CompactAlphabet(const uint8_t*& data, size_t length, std::vector<uint8_t>& compacted)
 {
-    winner = 0;
-    countCorrects = 0;
-    correctRuns = 0;
-    maxCorrectRuns = 0;
-    
-    MakePredictions();
+    std::array<uint8_t, 256> used = { 0, };
+    for (size_t i = 0; i < length; ++i) {
+        used[data[i]] = 1;
+    }
 
-    prediction_summary_t summary = {countAlphabets, maxCorrectRuns, countCorrects, countPredictions};
-    PredictionEvaluator pe;
-    return pe.Estimate(summary);
-}
+    std::array<uint8_t, 256> rank;
+    size_t count = 0;
+    size_t highest = 0;
+    for (size_t symbol = 0; symbol < used.size(); ++symbol) {
+        rank[symbol] = static_cast<uint8_t>(count);
+        count += used[symbol];
+        highest = used[symbol] ? symbol : highest;
+    }
 
-void PredictionEstimator::MakePredictions()
-{
-    Initialize();
+    if (highest + 1 == count) {
+        return count;
+    }
 
-    for (size_t i = startPredictionIndex; i < countSamples; ++i) {
-        UpdatePredictions(i);
-        CountCorrectPredictions(i);
-        UpdateScoreBoard(i);
+    compacted.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+        compacted[i] = rank[data[i]];
     }
+    data = compacted.data();
 
-    if (maxCorrectRuns < correctRuns) {
-        maxCorrectRuns = correctRuns;
+    return count;
+}
+
+static bool IsBinary(const uint8_t* data, size_t length)
+{
+    uint8_t bits = 0;
+    for (size_t i = 0; i < length; ++i) {
+        bits |= data[i];
     }
 
-    logstream << "countCorrects=" << countCorrects << ", max_run=" << maxCorrectRuns;
+    return bits < 2;
 }
 
-void PredictionEstimator::CountCorrectPredictions(size_t idx)
+/**
+ * Puts the sample and the alphabet size back once the predictions are done, even when they 
+ * throw, so that the estimator never keeps pointing into the compacted copy.
+ */
+struct SampleRestorer
 {
-    if (prediction[winner] == sample[idx]) {
-        correctRuns += 1;
-        countCorrects += 1;
+    const uint8_t*& sample;
+    size_t& countAlphabets;
+    const uint8_t* given;
+    size_t alphabet;
 
-    } else {
-        if (maxCorrectRuns < correctRuns) {
-            maxCorrectRuns = correctRuns;
-        }
-        correctRuns = 0;
+    SampleRestorer(const uint8_t*& sample, size_t& countAlphabets)
+        : sample(sample), countAlphabets(countAlphabets), given(sample), alphabet(countAlphabets)
+    {}
+
+    ~SampleRestorer()
+    {
+        sample = given;
+        countAlphabets = alphabet;
     }
-}
+};
 
-void PredictionEstimator::UpdateScoreBoard(size_t idx) 
+/**
+ * Literal samples are predicted over the symbols actually in use, so that the predictors are 
+ * specialized for as few as possible. They are kept above 2, as the binary predictors break ties 
+ * their own way, and the estimate is still bounded by the alphabet given. Only samples of 0 and 1 
+ * declared binary take the binary predictors; anything else is compacted first, so a wrong or 
+ * too small alphabet size can never index past the predictors.
+ */
+double PredictionEstimator::Estimate() 
 {
-    for (auto i = 0; i < scoreboard.size(); ++i) {
-        if (prediction[i] == sample[idx]) {
-            scoreboard[i] += 1;
+    countCorrects = 0;
+    correctRuns = 0;
+    maxCorrectRuns = 0;
 
-            if (scoreboard[i] >= scoreboard[winner]) {
-                winner = i;
-            }
+    std::vector<uint8_t> compacted;
+    {
+        SampleRestorer restorer(sample, countAlphabets);
+
+        if ((countAlphabets != 2) || !IsBinary(sample, countSamples)) {
+            countAlphabets = std::max<size_t>(CompactAlphabet(sample, countSamples, compacted), 3);
         }
+
+        MakePredictions();
     }
+
+    if (maxCorrectRuns < correctRuns) {
+        maxCorrectRuns = correctRuns;
+    }
+
+    logstream << "countCorrects=" << countCorrects << ", max_run=" << maxCorrectRuns;
+
+    prediction_summary_t summary = {countAlphabets, maxCorrectRuns, countCorrects, countPredictions};
+    PredictionEvaluator pe;
+    return pe.Estimate(summary);
 }
\ No newline at end of file
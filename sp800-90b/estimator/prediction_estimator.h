@@ -27,34 +27,36 @@
 
 #include "entropy_estimator.h"
 
-#include <vector>
-
 namespace randomness { namespace sp800_90b { namespace estimator {
 
     class PredictionEstimator : public EntropyEstimator 
     {
     protected:
         size_t countPredictions = 0;
-        size_t winner = 0;
         size_t correctRuns = 0;
         size_t countCorrects = 0;
         size_t maxCorrectRuns = 0;
         size_t startPredictionIndex = 0;
-        
-        std::vector<int16_t> prediction;
-        std::vector<size_t> scoreboard;
 
     public:
         double Estimate() override;
 
     protected:
-        virtual void Initialize() = 0;
-        virtual void UpdatePredictions(size_t idx) = 0;
-
-    private:
-        void MakePredictions();
-        void CountCorrectPredictions(size_t idx);
-        void UpdateScoreBoard(size_t idx);
+        virtual void MakePredictions() = 0;
+
+        void CountPrediction(bool correct)
+        {
+            if (correct) {
+                correctRuns += 1;
+                countCorrects += 1;
+            }
+            else {
+                if (maxCorrectRuns < correctRuns) {
+                    maxCorrectRuns = correctRuns;
+                }
+                correctRuns = 0;
+            }
+        }
     };
 }}}
 
@@ -26,6 +26,7 @@
 
 #include <cmath>
 
+#include "binary_tuple_counter.h"
 #include "boundary.h"
 
 using namespace randomness::sp800_90b::estimator;
@@ -35,24 +36,42 @@ std::string TupleEstimator::Name() const
     return "t-Tuple Estimate";
 }
 
-static inline size_t FindLargestT(const std::vector<size_t> Q, size_t max_lcp)
+static constexpr size_t MinimumTupleCount = 35;
+
+static inline size_t FindLargestT(const std::vector<size_t>& Q, size_t max_lcp)
 {
     size_t t = 1;
-    while ((Q[t] >= 35) && ((t++) < max_lcp));
+    while ((Q[t] >= MinimumTupleCount) && ((t++) < max_lcp));
     return t;
 }
 
 double TupleEstimator::Estimate()
 {    
+    // binary tuples are counted directly when the cut-off comes within 64 bits
+    std::vector<size_t> Q;
+    if ((countAlphabets == 2) && BinaryTupleCounter::Count(sample, countSamples, MinimumTupleCount, Q)) {
+        return CalculateEntropy(Q, Q.size() - 1, countSamples);
+    }
+
     auto lcp = LcpArray::Create(sample, countSamples);
     return Estimate(lcp);
 }
 
 double TupleEstimator::Estimate(const LcpArray& lcp)
+{
+    return Estimate(TupleStatistics::Create(lcp));
+}
+
+double TupleEstimator::Estimate(const TupleStatistics& statistics)
 {    
-    auto len = lcp.Array().size();
-    auto Q = GetMaximumTupleCounts(lcp, len);    
-    auto t = FindLargestT(Q, lcp.Max());
+    auto& Q = statistics.MaximumTupleCounts();
+    auto t = FindLargestT(Q, statistics.MaxLcp());
+
+    return CalculateEntropy(Q, t, statistics.Length());
+}
+
+double TupleEstimator::CalculateEntropy(const std::vector<size_t>& Q, size_t t, size_t len)
+{
     auto pmax = CalculateMaximumProbability(Q, t, len);
 
     logstream << "t=" << t - 1 << ", pmax=" << pmax;
@@ -74,52 +93,3 @@ double TupleEstimator::CalculateMaximumProbability(const std::vector<size_t>& Q,
 
     return pmax;
 }
-
-/**
- * Based on the code below:
- * https://github.com/usnistgov/SP800-90B_EntropyAssessment/blob/master/cpp/shared/lrs_test.h
- */
-std::vector<size_t> TupleEstimator::GetMaximumTupleCounts(const LcpArray& lcp, size_t length)
-{
-    auto max_lcp = lcp.Max();
-    auto Q = std::vector<size_t>(max_lcp + 1, 1);
-    auto A = std::vector<size_t>(max_lcp + 2, 0);
-    auto I = std::vector<size_t>(max_lcp + 3, 0);
-
-    int64_t j = 0;
-    for (size_t i = 1; i <= length; ++i) {
-        size_t c = 0;
-        if (lcp[i] < lcp[i - 1]) {
-            auto t = lcp[i - 1];
-            --j;
-
-            while (t > lcp[i]) {
-                if ((j > 0) && I[j] == t) {
-                    A[I[j]] += A[I[j + 1]];
-                    A[I[j + 1]] = 0;
-                    --j;
-                }
-
-                if (Q[t] >= A[I[j + 1]] + 1) {
-                    t = (j > 0) ? I[j] : lcp[i];
-                }
-                else {
-                    Q[t--] = A[I[j + 1]] + 1;
-                }
-            }
-
-            c = A[I[j + 1]];
-            A[I[j + 1]] = 0;
-        }
-
-        if (lcp[i] > 0) {
-            if ((j < 1) || (I[j] < lcp[i])) {
-                I[++j] = lcp[i];
-            }
-
-            A[I[j]] += c + 1;
-        }
-    }
-
-    return Q;
-}
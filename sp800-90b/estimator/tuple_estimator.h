@@ -26,7 +26,7 @@
 #define __RANDOMNESS_SP800_90B_ESTIMATOR_TUPLE_H__
 
 #include "entropy_estimator.h"
-#include "../../algorithm/lcp_array.h"
+#include "tuple_statistics.h"
 
 #include <vector>
 
@@ -39,12 +39,11 @@ namespace randomness { namespace sp800_90b { namespace estimator {
     public:
         std::string Name() const override;
         double Estimate() override;
-        virtual double Estimate(const LcpArray& lcp);
-
-    protected:
-        std::vector<size_t> GetMaximumTupleCounts(const LcpArray& lcp, size_t length);
+        double Estimate(const LcpArray& lcp);
+        virtual double Estimate(const TupleStatistics& statistics);
 
     private:
+        double CalculateEntropy(const std::vector<size_t>& Q, size_t t, size_t len);
         double CalculateMaximumProbability(const std::vector<size_t>& Q, size_t t, size_t length) const;
     };
 }}}
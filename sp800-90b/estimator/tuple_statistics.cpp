@@ -0,0 +1,265 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "tuple_statistics.h"
+
+#include <algorithm>
+
+using namespace randomness::sp800_90b::estimator;
+
+// below this many entries per thread, the merge would cost more than it saves
+static constexpr size_t MinimumChunkLength = 1 << 16;
+
+/**
+ * Lcp values from either end of a chunk at which the running minimum drops, with their distances 
+ * from that end. A run of values >= t starting at that end is as long as the distance of the 
+ * first drop below t.
+ */
+typedef std::vector<std::pair<size_t, size_t>> drops_t;
+
+struct chunk_t {
+    size_t length;
+    std::vector<size_t> Q;
+    std::vector<size_t> S;
+    drops_t heads;
+    drops_t tails;
+};
+
+static inline size_t CountPairs(size_t run)
+{
+    // a run of r lcp values >= t is a group of r + 1 suffixes sharing a t-tuple
+    return ((run + 1) * run) >> 1;
+}
+
+/**
+ * Fuses the two traversals of the code below into one, over the lcp values 0, lcp[begin..end), 0:
+ * https://github.com/usnistgov/SP800-90B_EntropyAssessment/blob/master/cpp/shared/lrs_test.h
+ *
+ * S is counted for every t >= 1. Counts only move from t + 1 down to t, so S[t] for t >= u is
+ * the same as when counting from u on, as the LRS estimate does.
+ */
+static void Traverse(const LcpArray& lcp, size_t begin, size_t end, std::vector<size_t>& Q, std::vector<size_t>& S)
+{
+    auto max_lcp = Q.size() - 1;
+
+    auto A = std::vector<size_t>(max_lcp + 2, 0);
+    auto I = std::vector<size_t>(max_lcp + 3, 0);
+    auto B = std::vector<size_t>(max_lcp + 2, 0);
+
+    int64_t j = 0;
+    size_t previous = 0;
+
+    for (auto i = begin; i <= end; ++i) {
+        auto current = (i < end) ? lcp[i] : 0;
+
+        // t-tuple: the largest number of occurrences of each length
+        size_t c = 0;
+        if (current < previous) {
+            auto t = previous;
+            --j;
+
+            while (t > current) {
+                if ((j > 0) && I[j] == t) {
+                    A[I[j]] += A[I[j + 1]];
+                    A[I[j + 1]] = 0;
+                    --j;
+                }
+
+                if (Q[t] >= A[I[j + 1]] + 1) {
+                    t = (j > 0) ? I[j] : current;
+                }
+                else {
+                    Q[t--] = A[I[j + 1]] + 1;
+                }
+            }
+
+            c = A[I[j + 1]];
+            A[I[j + 1]] = 0;
+        }
+
+        if (current > 0) {
+            if ((j < 1) || (I[j] < current)) {
+                I[++j] = current;
+            }
+
+            A[I[j]] += c + 1;
+        }
+
+        // LRS: the number of pairs of equal tuples of each length
+        if ((previous >= 1) && (current < previous)) {
+            for (auto t = previous; t > current; --t) {
+                B[t] += B[t + 1];
+                B[t + 1] = 0;
+
+                S[t] += ((B[t] + 1) * B[t]) >> 1;
+            }
+
+            if (current >= 1) {
+                B[current] += B[current + 1];
+            }
+
+            B[current + 1] = 0;
+        }
+
+        if (current >= 1) {
+            B[current]++;
+        }
+
+        previous = current;
+    }
+}
+
+static void FindDrops(const LcpArray& lcp, size_t begin, size_t end, drops_t& heads, drops_t& tails)
+{
+    for (auto i = begin; i < end; ++i) {
+        if (heads.empty() || (lcp[i] < heads.back().first)) {
+            heads.emplace_back(lcp[i], i - begin);
+        }
+    }
+
+    for (auto i = end; i > begin; --i) {
+        if (tails.empty() || (lcp[i - 1] < tails.back().first)) {
+            tails.emplace_back(lcp[i - 1], end - i);
+        }
+    }
+}
+
+// length of the run of values >= t, where cursor advances over the drops as t grows
+static inline size_t RunLength(const drops_t& drops, size_t& cursor, size_t t, size_t length)
+{
+    while ((cursor > 0) && (drops[cursor - 1].first < t)) {
+        --cursor;
+    }
+    return (cursor == drops.size()) ? length : drops[cursor].second;
+}
+
+TupleStatistics TupleStatistics::Create(const LcpArray& lcp, size_t countThreads)
+{
+    TupleStatistics statistics;
+    statistics.Build(lcp, countThreads);
+    return statistics;
+}
+
+/**
+ * The real lcp values lcp[1..length) are split into one chunk per thread, and each chunk is 
+ * traversed on its own as if closed by zeros on both sides. The groups of suffixes running into 
+ * a chunk boundary are then merged per t: their local pair counts are replaced by those of the 
+ * joined runs. Their local sizes never exceed the joined ones, so they can stay in Q.
+ */
+void TupleStatistics::Build(const LcpArray& lcp, size_t countThreads)
+{
+    length = lcp.Length();
+    max_lcp = lcp.Max();
+
+    Q.assign(max_lcp + 1, 1);
+    S.assign(max_lcp + 1, 0);
+
+    if (length < 2) {
+        return;
+    }
+
+    // the merge walks every chunk for every t, which only pays off for short repeats
+    auto countChunks = std::min(countThreads, (length - 1) / MinimumChunkLength);
+    if ((countChunks < 2) || ((max_lcp + 1) * countChunks > length)) {
+        Traverse(lcp, 1, length, Q, S);
+        return;
+    }
+
+    auto chunks = std::vector<chunk_t>(countChunks);
+
+    #pragma omp parallel for num_threads(countChunks) schedule(static, 1)
+    for (size_t c = 0; c < countChunks; ++c) {
+        auto begin = 1 + (length - 1) * c / countChunks;
+        auto end = 1 + (length - 1) * (c + 1) / countChunks;
+        auto& chunk = chunks[c];
+
+        FindDrops(lcp, begin, end, chunk.heads, chunk.tails);
+
+        size_t local_max = 0;
+        for (auto i = begin; i < end; ++i) {
+            local_max = std::max(local_max, lcp[i]);
+        }
+
+        chunk.length = end - begin;
+        chunk.Q.assign(local_max + 1, 1);
+        chunk.S.assign(local_max + 1, 0);
+        Traverse(lcp, begin, end, chunk.Q, chunk.S);
+    }
+
+    auto heads = std::vector<size_t>(countChunks);
+    auto tails = std::vector<size_t>(countChunks);
+    for (size_t c = 0; c < countChunks; ++c) {
+        heads[c] = chunks[c].heads.size();
+        tails[c] = chunks[c].tails.size();
+    }
+
+    for (size_t t = 1; t <= max_lcp; ++t) {
+        size_t run = 0;
+
+        for (size_t c = 0; c < countChunks; ++c) {
+            auto& chunk = chunks[c];
+            if (t < chunk.Q.size()) {
+                Q[t] = std::max(Q[t], chunk.Q[t]);
+                S[t] += chunk.S[t];
+            }
+
+            auto head = RunLength(chunk.heads, heads[c], t, chunk.length);
+            auto tail = RunLength(chunk.tails, tails[c], t, chunk.length);
+
+            if (head == chunk.length) {
+                S[t] -= CountPairs(head);
+                run += head;
+                continue;
+            }
+
+            S[t] -= CountPairs(head) + CountPairs(tail);
+            S[t] += CountPairs(run + head);
+            Q[t] = std::max(Q[t], run + head + 1);
+            run = tail;
+        }
+
+        S[t] += CountPairs(run);
+        Q[t] = std::max(Q[t], run + 1);
+    }
+}
+
+size_t TupleStatistics::Length() const
+{
+    return length;
+}
+
+size_t TupleStatistics::MaxLcp() const
+{
+    return max_lcp;
+}
+
+const std::vector<size_t>& TupleStatistics::MaximumTupleCounts() const
+{
+    return Q;
+}
+
+const std::vector<size_t>& TupleStatistics::TuplePairCounts() const
+{
+    return S;
+}
\ No newline at end of file
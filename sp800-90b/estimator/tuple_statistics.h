@@ -0,0 +1,64 @@
+/**
+ * The MIT License
+ *
+ * Copyright (c) 2020 Ilwoong Jeong (https://github.com/ilwoong)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __RANDOMNESS_SP800_90B_ESTIMATOR_TUPLE_STATISTICS_H__
+#define __RANDOMNESS_SP800_90B_ESTIMATOR_TUPLE_STATISTICS_H__
+
+#include "../../algorithm/lcp_array.h"
+
+#include <vector>
+
+namespace randomness { namespace sp800_90b { namespace estimator {
+
+    using namespace randomness::algorithm;
+
+    /**
+     * Counts shared by the t-Tuple and LRS estimates, collected in a single pass over the LCP array.
+     * Q[t] is the number of occurrences of the most common t-tuple, and S[t] is the number of
+     * pairs of equal t-tuples.
+     */
+    class TupleStatistics {
+    private:
+        size_t length;
+        size_t max_lcp;
+        std::vector<size_t> Q;
+        std::vector<size_t> S;
+
+    public:
+        static TupleStatistics Create(const LcpArray& lcp, size_t countThreads = 1);
+
+    private:
+        void Build(const LcpArray& lcp, size_t countThreads);
+
+        friend class OnlineTupleStatistics;
+
+    public:
+        size_t Length() const;
+        size_t MaxLcp() const;
+        const std::vector<size_t>& MaximumTupleCounts() const;
+        const std::vector<size_t>& TuplePairCounts() const;
+    };
+}}}
+
+#endif
\ No newline at end of file
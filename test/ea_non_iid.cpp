@@ -23,9 +23,11 @@
  */
 
 #include "../sp800-90b/estimators.h"
+#include "../algorithm/lcp_cache.h"
 
 #include <array>
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -40,6 +42,9 @@ using namespace randomness::algorithm;
 
 static constexpr size_t MILLION = 1000000;
 
+// when set, LCP arrays of samples seen before are reloaded from the directory it names
+static constexpr const char* LcpCacheVariable = "RANDOMNESS_LCP_CACHE";
+
 std::streamsize read_bytes(char* data, const char* filepath, std::streamsize length)
 {
     std::ifstream ifs;    
@@ -87,14 +92,24 @@ std::vector<std::shared_ptr<EntropyEstimator>> get_estimators(bool forBinary)
     estimators.push_back(std::make_shared<TupleEstimator>());
     estimators.push_back(std::make_shared<LrsEstimator>());
 
-    estimators.push_back(std::make_shared<MultiMcwPredictionEstimator>());
-    estimators.push_back(std::make_shared<LagPredictionEstimator>());
+    estimators.push_back(std::make_shared<MultiMcwPredictionEstimator>(omp_get_max_threads()));
+    estimators.push_back(std::make_shared<LagPredictionEstimator>(omp_get_max_threads()));
     estimators.push_back(std::make_shared<MultiMmcPredictionEstimator>());
     estimators.push_back(std::make_shared<Lz78yPredictionEstimator>());
 
     return estimators;
 }
 
+LcpArray build_lcp(const uint8_t* data, size_t length)
+{
+    auto directory = std::getenv(LcpCacheVariable);
+    if ((directory == nullptr) || (directory[0] == '\0')) {
+        return LcpArray::Create(data, length, omp_get_max_threads());
+    }
+
+    return LcpCache(directory).Load(data, length, omp_get_max_threads());
+}
+
 void run_estimators(const char* filepath, size_t alph_size) 
 {    
     std::vector<uint8_t> data(MILLION, 0);
@@ -117,9 +132,12 @@ void run_estimators(const char* filepath, size_t alph_size)
     auto estimators = get_estimators(alph_size == 2);
     double total_elapsed = omp_get_wtime();
 
-    auto lcp = LcpArray::Create(pdata, data_length);
+    auto lcp = build_lcp(pdata, data_length);
     std::cout << "Building LCP array is done!!" << std::endl;
 
+    // one pass over the LCP array serves both the t-Tuple and LRS estimates
+    auto tuple_statistics = TupleStatistics::Create(lcp, omp_get_max_threads());
+
     for (int i = 0; i < estimators.size(); ++i) {
         auto estimator = estimators[i].get();
         auto elapsed = omp_get_wtime();
@@ -127,7 +145,7 @@ void run_estimators(const char* filepath, size_t alph_size)
 
         auto tuple_estimator = dynamic_cast<TupleEstimator*>(estimator);
         if (tuple_estimator != nullptr) {
-            entropy = tuple_estimator->Estimate(lcp);
+            entropy = tuple_estimator->Estimate(tuple_statistics);
         } else {
             entropy = estimator->Estimate(pdata, data_length, alph_size);
         }
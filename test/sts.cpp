@@ -22,9 +22,12 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "../common/sample_reader.h"
 #include "../sp800-22/evaluators.h"
@@ -32,7 +35,11 @@
 using namespace randomness::common;
 using namespace randomness::sp800_22;
 
+static const std::string SamplePath = "./samples/random_1MB.bin";
+static constexpr size_t SampleLengthInBits = 1000000;
+
 static constexpr size_t TitleWidth = 20;
+static constexpr size_t ChunkLengthInBits = 65536;
 
 std::vector<std::shared_ptr<StatisticalTest>> PopulateTests()
 {
@@ -45,6 +52,29 @@ std::vector<std::shared_ptr<StatisticalTest>> PopulateTests()
     return tests;
 }
 
+// tests missing here are screened last, in the order PopulateTests() gives them
+static const std::vector<std::string> CheapestFirst = { "Monobit", "Runs", "Blk.Freq.", "Longest Run" };
+
+static size_t ScreeningCost(const std::shared_ptr<StatisticalTest>& test)
+{
+    auto found = std::find(CheapestFirst.begin(), CheapestFirst.end(), test->ShortName());
+    return static_cast<size_t>(found - CheapestFirst.begin());
+}
+
+/**
+ * Tests of PopulateTests() ordered from the cheapest to the most expensive one, 
+ * so that a defective sample is rejected as early as possible.
+ */
+std::vector<std::shared_ptr<StatisticalTest>> PopulateScreeningTests()
+{
+    auto tests = PopulateTests();
+    std::stable_sort(tests.begin(), tests.end(), [](const std::shared_ptr<StatisticalTest>& lhs, const std::shared_ptr<StatisticalTest>& rhs) {
+        return ScreeningCost(lhs) < ScreeningCost(rhs);
+    });
+
+    return tests;
+}
+
 static void PrintResultItem(std::vector<randomness_result_t> results, std::string log) 
 {
     for (auto item : results) {
@@ -62,11 +92,214 @@ static void PrintResultItem(std::vector<randomness_result_t> results, std::strin
     }
 }
 
+static void EvaluateStreaming(const std::string& filepath, size_t lengthInBits)
+{
+    SampleReader reader;
+    reader.Open(filepath);
+
+    auto tests = PopulateTests();
+    for (auto test : tests) {
+        test->Begin(lengthInBits);
+    }
+
+    for (size_t remains = lengthInBits; remains > 0; ) {
+        auto chunk = reader.NextBits(std::min(remains, ChunkLengthInBits));
+        if (chunk->BinaryData().empty()) {
+            break;
+        }
+        remains -= chunk->BinaryData().size();
+
+        for (auto test : tests) {
+            test->Accumulate(*chunk);
+        }
+    }
+
+    std::cout << lengthInBits << " bits were streamed in chunks of " << ChunkLengthInBits << " bits" << std::endl;
+
+    for (auto test : tests) {
+        auto results = test->Finalize();
+        PrintResultItem(results, test->Log());
+    }
+
+    reader.Close();
+}
+
+static void MonitorWindow(const std::string& filepath, size_t windowLengthInBits)
+{
+    SampleReader reader;
+    reader.Open(filepath);
+
+    MonobitMonitor monobit(windowLengthInBits);
+    BlockFrequencyMonitor blockFrequency(windowLengthInBits);
+    RunsMonitor runs(windowLengthInBits);
+
+    for (size_t remains = reader.Length(); remains > 0; ) {
+        auto chunk = reader.NextBytes(std::min(remains, ChunkLengthInBits >> 3));
+        auto& data = chunk->OctalData();
+        if (data.empty()) {
+            break;
+        }
+        remains -= data.size();
+
+        monobit.Push(data.data(), data.size());
+        blockFrequency.Push(data.data(), data.size());
+        runs.Push(data.data(), data.size());
+    }
+
+    std::cout << "last " << windowLengthInBits << " bits of " << (reader.Length() << 3) << " bits were monitored" << std::endl;
+
+    auto results = monobit.EvaluateWindow();
+    PrintResultItem(results, monobit.Log());
+
+    results = blockFrequency.EvaluateWindow();
+    PrintResultItem(results, blockFrequency.Log());
+
+    results = runs.EvaluateWindow();
+    PrintResultItem(results, runs.Log());
+
+    reader.Close();
+}
+
+static void PrintUsage()
+{
+    std::cerr << "usage: sts [--stream | --monitor <bits>]" << std::endl;
+    std::cerr << "       sts --screen <alpha> <file>..." << std::endl;
+}
+
+// only a whole decimal number is taken, as std::stoull() alone would accept "-1" or "12abc"
+static bool ParseLength(const std::string& text, size_t& value)
+{
+    if (text.empty() || (std::isdigit(static_cast<unsigned char>(text[0])) == 0)) {
+        return false;
+    }
+
+    try {
+        size_t parsed = 0;
+        value = std::stoull(text, &parsed);
+        return parsed == text.size();
+    } catch (std::logic_error&) {
+        return false;
+    }
+}
+
+// a significance level is a probability strictly between 0 and 1
+static bool ParseAlpha(const std::string& text, double& value)
+{
+    try {
+        size_t parsed = 0;
+        value = std::stod(text, &parsed);
+        return (parsed == text.size()) && (value > 0) && (value < 1);
+    } catch (std::logic_error&) {
+        return false;
+    }
+}
+
+static bool Screen(const std::string& filepath, double alpha)
+{
+    SampleReader reader;
+    reader.Open(filepath);
+    auto sample = reader.NextBytes(reader.Length());
+    reader.Close();
+
+    auto countEvaluated = 0;
+    std::string skipped;
+
+    for (auto test : PopulateScreeningTests()) {
+        if (sample->BinaryData().size() < test->MinimumLengthInBits()) {
+            skipped += (skipped.empty() ? "" : ", ") + test->ShortName();
+            continue;
+        }
+
+        for (auto item : test->Evaluate(*sample)) {
+            if (item.pvalue < alpha) {
+                std::cout << filepath << ": FAIL at " << item.shortname << ", P-value = " << item.pvalue << std::endl;
+                return false;
+            }
+        }
+        countEvaluated += 1;
+    }
+
+    // a sample no test could look at is not known to be good
+    if (countEvaluated == 0) {
+        std::cout << filepath << ": FAIL (too short), " << sample->BinaryData().size() << " bits" << std::endl;
+        return false;
+    }
+
+    std::cout << filepath << ": PASS";
+    if (skipped.empty() == false) {
+        std::cout << ", skipped " << skipped << " (too short)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+static int ScreenAll(int argc, const char** argv)
+{
+    auto alpha = 0.0;
+    if ((argc < 4) || (ParseAlpha(argv[2], alpha) == false)) {
+        PrintUsage();
+        return 1;
+    }
+
+    auto failures = 0;
+
+    for (auto i = 3; i < argc; ++i) {
+        try {
+            if (Screen(argv[i], alpha) == false) {
+                failures += 1;
+            }
+        } catch (std::string& e) {
+            std::cout << argv[i] << ": " << e << std::endl;
+            failures += 1;
+        } catch (std::exception& e) {
+            std::cout << argv[i] << ": " << e.what() << std::endl;
+            failures += 1;
+        }
+    }
+
+    std::cout << failures << " of " << argc - 3 << " samples were rejected with alpha = " << alpha << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
+
 int main(int argc, const char** argv)
 {
+    // usage: sts --screen <alpha> <file>...
+    if ((argc >= 2) && (std::string(argv[1]) == "--screen")) {
+        return ScreenAll(argc, argv);
+    }
+
+    // usage: sts --stream
+    if ((argc == 2) && (std::string(argv[1]) == "--stream")) {
+        EvaluateStreaming(SamplePath, SampleLengthInBits);
+        return 0;
+    }
+
+    // usage: sts --monitor <bits>
+    if ((argc >= 2) && (std::string(argv[1]) == "--monitor")) {
+        size_t windowLengthInBits = 0;
+        if ((argc != 3) || (ParseLength(argv[2], windowLengthInBits) == false)) {
+            PrintUsage();
+            return 1;
+        }
+
+        try {
+            MonitorWindow(SamplePath, windowLengthInBits);
+        } catch (std::invalid_argument& e) {
+            std::cerr << e.what() << ": " << argv[2] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc > 1) {
+        PrintUsage();
+        return 1;
+    }
+
     SampleReader reader;
-    reader.Open("./samples/random_1MB.bin");
-    auto sample = reader.NextBits(1000000);
+    reader.Open(SamplePath);
+    auto sample = reader.NextBits(SampleLengthInBits);
 
     std::cout << sample->BinaryData().size() << " bits / ";
     std::cout << sample->OctalData().size() << " bytes samples were loaded" << std::endl;